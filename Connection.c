@@ -3,6 +3,19 @@
 //   Definition of the Python type OracleConnection.
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// structure for the arguments of a connection which is established lazily
+//-----------------------------------------------------------------------------
+typedef struct {
+    PyObject *cclassObj;
+    PyObject *tagObj;
+    PyObject *newPasswordObj;
+    ub4 purity;
+    ub4 connectMode;
+    int twophase;
+    int matchAnyTag;
+} udt_DeferredConnect;
+
 //-----------------------------------------------------------------------------
 // structure for the Python type "Connection"
 //-----------------------------------------------------------------------------
@@ -19,13 +32,30 @@ typedef struct {
     PyObject *password;
     PyObject *dsn;
     PyObject *version;
+    PyObject *tag;
     ub4 commitMode;
     int autocommit;
     int release;
     int attached;
+    int transactionInProgress;
+    int tagMatched;
+    int connectPending;
+    int connectInProgress;
+    int skipPoolStats;
+    int acquiredFromPool;
+    udt_DeferredConnect deferred;
 } udt_Connection;
 
 
+//-----------------------------------------------------------------------------
+// free list of connection objects acquired from session pools; the cloned
+// environment is retained so that it does not need to be created again
+//-----------------------------------------------------------------------------
+#define MAX_FREE_CONNECTIONS            16
+static udt_Connection *g_FreeConnections[MAX_FREE_CONNECTIONS];
+static int g_NumFreeConnections = 0;
+
+
 //-----------------------------------------------------------------------------
 // constants for the OCI attributes
 //-----------------------------------------------------------------------------
@@ -47,13 +77,16 @@ static ub4 gc_CurrentSchemaAttribute = OCI_ATTR_CURRENT_SCHEMA;
 static void Connection_Free(udt_Connection*);
 static PyObject *Connection_New(PyTypeObject*, PyObject*, PyObject*);
 static int Connection_Init(udt_Connection*, PyObject*, PyObject*);
+static int Connection_CompleteConnect(udt_Connection*);
+static void Connection_WaitForConnect(udt_Connection*);
+static void Connection_FreeSessionHandles(udt_Connection*);
 static PyObject *Connection_Repr(udt_Connection*);
 static PyObject *Connection_Close(udt_Connection*, PyObject*);
 static PyObject *Connection_Commit(udt_Connection*, PyObject*);
 static PyObject *Connection_Begin(udt_Connection*, PyObject*);
 static PyObject *Connection_Prepare(udt_Connection*, PyObject*);
 static PyObject *Connection_Rollback(udt_Connection*, PyObject*);
-static PyObject *Connection_NewCursor(udt_Connection*, PyObject*);
+static PyObject *Connection_NewCursor(udt_Connection*, PyObject*, PyObject*);
 static PyObject *Connection_Cancel(udt_Connection*, PyObject*);
 static PyObject *Connection_RegisterCallback(udt_Connection*, PyObject*);
 static PyObject *Connection_UnregisterCallback(udt_Connection*, PyObject*);
@@ -84,7 +117,8 @@ static PyObject *Connection_Subscribe(udt_Connection*, PyObject*, PyObject*);
 // declaration of methods for Python type "Connection"
 //-----------------------------------------------------------------------------
 static PyMethodDef g_ConnectionMethods[] = {
-    { "cursor", (PyCFunction) Connection_NewCursor, METH_NOARGS },
+    { "cursor", (PyCFunction) Connection_NewCursor,
+            METH_VARARGS | METH_KEYWORDS },
     { "commit", (PyCFunction) Connection_Commit, METH_NOARGS },
     { "rollback", (PyCFunction) Connection_Rollback, METH_NOARGS },
     { "begin", (PyCFunction) Connection_Begin, METH_VARARGS },
@@ -125,6 +159,8 @@ static PyMemberDef g_ConnectionMembers[] = {
             offsetof(udt_Connection, inputTypeHandler), 0 },
     { "outputtypehandler", T_OBJECT,
             offsetof(udt_Connection, outputTypeHandler), 0 },
+    { "tag", T_OBJECT, offsetof(udt_Connection, tag), READONLY },
+    { "tagmatched", T_INT, offsetof(udt_Connection, tagMatched), READONLY },
     { NULL }
 };
 
@@ -208,11 +244,15 @@ static PyTypeObject g_ConnectionType = {
 //-----------------------------------------------------------------------------
 // Connection_IsConnected()
 //   Determines if the connection object is connected to the database. If not,
-// a Python exception is raised.
+// a Python exception is raised. Connections which were created lazily are
+// connected the first time this check is made.
 //-----------------------------------------------------------------------------
 static int Connection_IsConnected(
     udt_Connection *self)               // connection to check
 {
+    Connection_WaitForConnect(self);
+    if (!self->handle && self->connectPending)
+        return Connection_CompleteConnect(self);
     if (!self->handle) {
         PyErr_SetString(g_InterfaceErrorException, "not connected");
         return -1;
@@ -221,6 +261,90 @@ static int Connection_IsConnected(
 }
 
 
+//-----------------------------------------------------------------------------
+// Connection_SetAuthInfo()
+//   Set the credentials, connection class and purity on the authorization
+// handle used for acquiring a session. Whether external credentials are to be
+// used (no user name or password are set) is returned.
+//-----------------------------------------------------------------------------
+static int Connection_SetAuthInfo(
+    udt_Connection *self,               // connection
+    udt_Environment *environment,       // environment to use
+    OCIAuthInfo *authInfo,              // authorization handle
+    PyObject *cclassObj,                // connection class (DRCP)
+    ub4 purity,                         // purity (DRCP)
+    int *externalCredentials)           // use external credentials? (out)
+{
+    udt_Buffer buffer;
+    sword status;
+
+    // set the user name, if applicable
+    *externalCredentials = 1;
+    if (cxBuffer_FromObject(&buffer, self->username,
+            self->environment->encoding) < 0)
+        return -1;
+    if (buffer.size > 0) {
+        *externalCredentials = 0;
+        status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO,
+                (text*) buffer.ptr, buffer.size, OCI_ATTR_USERNAME,
+                environment->errorHandle);
+        if (Environment_CheckForError(environment, status,
+                "Connection_SetAuthInfo(): set user name") < 0) {
+            cxBuffer_Clear(&buffer);
+            return -1;
+        }
+    }
+    cxBuffer_Clear(&buffer);
+
+    // set the password, if applicable
+    if (cxBuffer_FromObject(&buffer, self->password,
+            self->environment->encoding) < 0)
+        return -1;
+    if (buffer.size > 0) {
+        *externalCredentials = 0;
+        status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO,
+                (text*) buffer.ptr, buffer.size, OCI_ATTR_PASSWORD,
+                environment->errorHandle);
+        if (Environment_CheckForError(environment, status,
+                "Connection_SetAuthInfo(): set password") < 0) {
+            cxBuffer_Clear(&buffer);
+            return -1;
+        }
+    }
+    cxBuffer_Clear(&buffer);
+
+#ifdef ORACLE_11G
+    // set the connection class, if applicable
+    if (cxBuffer_FromObject(&buffer, cclassObj,
+            self->environment->encoding) < 0)
+        return -1;
+    if (buffer.size > 0) {
+        status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO,
+                (text*) buffer.ptr, buffer.size, OCI_ATTR_CONNECTION_CLASS,
+                environment->errorHandle);
+        if (Environment_CheckForError(environment, status,
+                "Connection_SetAuthInfo(): set connection class") < 0) {
+            cxBuffer_Clear(&buffer);
+            return -1;
+        }
+    }
+    cxBuffer_Clear(&buffer);
+
+    // set the purity, if applicable
+    if (purity != OCI_ATTR_PURITY_DEFAULT) {
+        status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO, &purity,
+                sizeof(purity), OCI_ATTR_PURITY,
+                environment->errorHandle);
+        if (Environment_CheckForError(environment, status,
+                "Connection_SetAuthInfo(): set purity") < 0)
+            return -1;
+    }
+#endif
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // Connection_GetConnection()
 //   Get a connection using the OCISessionGet() interface rather than using
@@ -230,16 +354,20 @@ static int Connection_GetConnection(
     udt_Connection *self,               // connection
     udt_SessionPool *pool,              // pool to acquire connection from
     PyObject *cclassObj,                // connection class (DRCP)
-    ub4 purity)                         // purity (DRCP)
+    ub4 purity,                         // purity (DRCP)
+    PyObject *tagObj,                   // session tag requested
+    int matchAnyTag)                    // accept a session with any tag?
 {
-    int externalCredentials, proxyCredentials;
+    int externalCredentials, proxyCredentials, result;
     udt_Environment *environment;
-    udt_Buffer buffer;
+    udt_Buffer buffer, tagBuffer;
+    ub4 mode, returnedTagLength;
     OCIAuthInfo *authInfo;
     PyObject *dbNameObj;
+    PY_LONG_LONG startTime;
+    char *returnedTag;
     boolean found;
     sword status;
-    ub4 mode;
 
     // set things up for the call to acquire a session
     authInfo = NULL;
@@ -271,92 +399,84 @@ static int Connection_GetConnection(
                 "Connection_GetConnection(): allocate handle") < 0)
             return -1;
 
-        // set the user name, if applicable
-        externalCredentials = 1;
-        if (cxBuffer_FromObject(&buffer, self->username,
-                self->environment->encoding) < 0)
-            return -1;
-        if (buffer.size > 0) {
-            externalCredentials = 0;
-            status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO,
-                    (text*) buffer.ptr, buffer.size, OCI_ATTR_USERNAME,
-                    environment->errorHandle);
-            if (Environment_CheckForError(environment, status,
-                    "Connection_GetConnection(): set user name") < 0) {
-                cxBuffer_Clear(&buffer);
-                return -1;
-            }
-        }
-        cxBuffer_Clear(&buffer);
-
-        // set the password, if applicable
-        if (cxBuffer_FromObject(&buffer, self->password,
-                self->environment->encoding) < 0)
+        // set the credentials, connection class and purity
+        if (Connection_SetAuthInfo(self, environment, authInfo, cclassObj,
+                purity, &externalCredentials) < 0) {
+            OCIHandleFree(authInfo, OCI_HTYPE_AUTHINFO);
             return -1;
-        if (buffer.size > 0) {
-            externalCredentials = 0;
-            status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO,
-                    (text*) buffer.ptr, buffer.size, OCI_ATTR_PASSWORD,
-                    environment->errorHandle);
-            if (Environment_CheckForError(environment, status,
-                    "Connection_GetConnection(): set password") < 0) {
-                cxBuffer_Clear(&buffer);
-                return -1;
-            }
         }
-        cxBuffer_Clear(&buffer);
 
         // if no user name or password are set, using external credentials
         if (!pool && externalCredentials)
             mode |= OCI_SESSGET_CREDEXT;
+    }
 
-#ifdef ORACLE_11G
-        // set the connection class, if applicable
-        if (cxBuffer_FromObject(&buffer, cclassObj,
-                self->environment->encoding) < 0)
-            return -1;
-        if (buffer.size > 0) {
-            status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO,
-                    (text*) buffer.ptr, buffer.size, OCI_ATTR_CONNECTION_CLASS,
-                    environment->errorHandle);
-            if (Environment_CheckForError(environment, status,
-                    "Connection_GetConnection(): set connection class") < 0) {
-                cxBuffer_Clear(&buffer);
-                return -1;
-            }
-        }
-        cxBuffer_Clear(&buffer);
-
-        // set the purity, if applicable
-        if (purity != OCI_ATTR_PURITY_DEFAULT) {
-            status = OCIAttrSet(authInfo, OCI_HTYPE_AUTHINFO, &purity,
-                    sizeof(purity), OCI_ATTR_PURITY,
-                    environment->errorHandle);
-            if (Environment_CheckForError(environment, status,
-                    "Connection_GetConnection(): set purity") < 0)
-                return -1;
-        }
-#endif
+    // prepare the tag, if applicable
+    if (tagObj == Py_None)
+        tagObj = NULL;
+    if (cxBuffer_FromObject(&tagBuffer, tagObj,
+            self->environment->encoding) < 0) {
+        if (authInfo)
+            OCIHandleFree(authInfo, OCI_HTYPE_AUTHINFO);
+        return -1;
     }
+    if (tagObj && matchAnyTag)
+        mode |= OCI_SESSGET_SPOOL_MATCHANY;
 
     // acquire the new session
     if (cxBuffer_FromObject(&buffer, dbNameObj,
-            self->environment->encoding) < 0)
+            self->environment->encoding) < 0) {
+        cxBuffer_Clear(&tagBuffer);
+        if (authInfo)
+            OCIHandleFree(authInfo, OCI_HTYPE_AUTHINFO);
         return -1;
+    }
+    returnedTag = NULL;
+    returnedTagLength = 0;
+    found = 0;
+    startTime = (pool) ? SessionPool_GetTime() : 0;
     Py_BEGIN_ALLOW_THREADS
     status = OCISessionGet(environment->handle, environment->errorHandle,
-            &self->handle, authInfo, (text*) buffer.ptr, buffer.size, NULL, 0,
-            NULL, NULL, &found, mode);
+            &self->handle, authInfo, (text*) buffer.ptr, buffer.size,
+            (OraText*) tagBuffer.ptr, tagBuffer.size,
+            (OraText**) &returnedTag, &returnedTagLength, &found, mode);
     Py_END_ALLOW_THREADS
     cxBuffer_Clear(&buffer);
-    if (Environment_CheckForError(environment, status,
-            "Connection_GetConnection(): get connection") < 0)
-        return -1;
+    cxBuffer_Clear(&tagBuffer);
 
     // eliminate the authorization handle immediately, if applicable
     if (authInfo)
         OCIHandleFree(authInfo, OCI_HTYPE_AUTHINFO);
 
+    // check for errors, updating the statistics of the pool unless that is
+    // left to the caller (when acquiring with a timeout and retrying)
+    result = Environment_CheckForError(environment, status,
+            "Connection_GetConnection(): get connection");
+    if (pool && !self->skipPoolStats)
+        SessionPool_AcquireCompleted(pool, result,
+                SessionPool_GetTime() - startTime);
+    if (result < 0)
+        return -1;
+
+    // note the tag of the session returned and whether it matched; if the tag
+    // cannot be decoded the session is released again
+    if (returnedTag && returnedTagLength > 0) {
+        self->tag = cxString_FromEncodedString(returnedTag,
+                returnedTagLength, self->environment->encoding);
+        if (!self->tag) {
+            Py_BEGIN_ALLOW_THREADS
+            OCISessionRelease(self->handle, environment->errorHandle, NULL, 0,
+                    OCI_DEFAULT);
+            Py_END_ALLOW_THREADS
+            self->handle = NULL;
+            return -1;
+        }
+    } else {
+        Py_INCREF(Py_None);
+        self->tag = Py_None;
+    }
+    self->tagMatched = (tagObj && found) ? 1 : 0;
+
     // copy members in the case where a pool is being used
     if (pool) {
         if (!proxyCredentials) {
@@ -369,6 +489,7 @@ static int Connection_GetConnection(
         self->dsn = pool->dsn;
         Py_INCREF(pool);
         self->sessionPool = pool;
+        self->acquiredFromPool = 1;
     }
 
     self->release = 1;
@@ -376,6 +497,140 @@ static int Connection_GetConnection(
 }
 
 
+//-----------------------------------------------------------------------------
+// Connection_DeferConnect()
+//   Retain the arguments needed to establish the connection so that doing so
+// can be deferred until the connection is first used. If the connection is
+// to be acquired from a session pool, the pool is expected to be set already
+// so that the connection can be released to it without being used.
+//-----------------------------------------------------------------------------
+static void Connection_DeferConnect(
+    udt_Connection *self,               // connection
+    PyObject *cclassObj,                // connection class (DRCP)
+    ub4 purity,                         // purity (DRCP)
+    PyObject *tagObj,                   // session tag requested
+    int matchAnyTag,                    // accept a session with any tag?
+    ub4 connectMode,                    // mode to connect as
+    int twophase,                       // allow two phase commit?
+    PyObject *newPasswordObj)           // new password (if desired)
+{
+    Py_XINCREF(cclassObj);
+    self->deferred.cclassObj = cclassObj;
+    Py_XINCREF(tagObj);
+    self->deferred.tagObj = tagObj;
+    Py_XINCREF(newPasswordObj);
+    self->deferred.newPasswordObj = newPasswordObj;
+    self->deferred.purity = purity;
+    self->deferred.matchAnyTag = matchAnyTag;
+    self->deferred.connectMode = connectMode;
+    self->deferred.twophase = twophase;
+    self->connectPending = 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// Connection_ClearDeferred()
+//   Clear the arguments retained for establishing the connection lazily.
+//-----------------------------------------------------------------------------
+static void Connection_ClearDeferred(
+    udt_Connection *self)               // connection
+{
+    Py_CLEAR(self->deferred.cclassObj);
+    Py_CLEAR(self->deferred.tagObj);
+    Py_CLEAR(self->deferred.newPasswordObj);
+    self->connectPending = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Connection_NewFromPool()
+//   Create a connection object of the default type and acquire a session for
+// it from the pool directly, avoiding the overhead of calling the type and
+// parsing keyword arguments. Connection objects on the free list are reused
+// along with their environment, if it was cloned from the same pool.
+//-----------------------------------------------------------------------------
+static udt_Connection *Connection_NewFromPool(
+    udt_SessionPool *pool,              // pool to acquire connection from
+    PyObject *cclassObj,                // connection class (DRCP)
+    ub4 purity,                         // purity (DRCP)
+    PyObject *tagObj,                   // session tag requested
+    int matchAnyTag,                    // accept a session with any tag?
+    int lazy,                           // defer acquiring the session?
+    int skipPoolStats)                  // caller updates pool statistics?
+{
+    udt_Environment *environment;
+    udt_Connection *self;
+
+    // reuse a connection object from the free list, if possible
+    if (g_NumFreeConnections > 0) {
+        self = g_FreeConnections[--g_NumFreeConnections];
+        environment = self->environment;
+        memset((char*) self + sizeof(PyObject), 0,
+                sizeof(udt_Connection) - sizeof(PyObject));
+        PyObject_Init((PyObject*) self, &g_ConnectionType);
+        self->commitMode = OCI_DEFAULT;
+        if (environment->cloneEnv == (PyObject*) pool->environment)
+            self->environment = environment;
+        else Py_DECREF(environment);
+    } else {
+        self = (udt_Connection*) Connection_New(&g_ConnectionType, NULL,
+                NULL);
+        if (!self)
+            return NULL;
+    }
+
+    // clone the environment of the pool, if needed
+    if (!self->environment) {
+        self->environment = Environment_Clone(pool->environment);
+        if (!self->environment) {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    // acquire the session, unless that is deferred until it is needed
+    self->skipPoolStats = skipPoolStats;
+    if (lazy) {
+        Py_INCREF(pool);
+        self->sessionPool = pool;
+        self->acquiredFromPool = 1;
+        Connection_DeferConnect(self, cclassObj, purity, tagObj, matchAnyTag,
+                OCI_DEFAULT, 0, NULL);
+    } else if (Connection_GetConnection(self, pool, cclassObj, purity, tagObj,
+            matchAnyTag) < 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+
+
+//-----------------------------------------------------------------------------
+// Connection_ClearFreeList()
+//   Deallocate the connection objects on the free list whose environment was
+// cloned from the given environment. This is called when a session pool is
+// deallocated so that the connections it parked do not keep its environment
+// alive.
+//-----------------------------------------------------------------------------
+static void Connection_ClearFreeList(
+    udt_Environment *environment)       // environment of the pool
+{
+    udt_Connection *connection;
+    int i, numRetained;
+
+    numRetained = 0;
+    for (i = 0; i < g_NumFreeConnections; i++) {
+        connection = g_FreeConnections[i];
+        if (connection->environment->cloneEnv == (PyObject*) environment) {
+            Py_CLEAR(connection->environment);
+            Py_TYPE(connection)->tp_free((PyObject*) connection);
+        } else g_FreeConnections[numRetained++] = connection;
+    }
+    g_NumFreeConnections = numRetained;
+}
+
+
 #ifdef ORACLE_10G
 //-----------------------------------------------------------------------------
 // Connection_GetOCIAttr()
@@ -507,6 +762,7 @@ static int Connection_Attach(
         return -1;
 
     self->attached = 1;
+    self->transactionInProgress = 1;
     return 0;
 }
 
@@ -720,6 +976,7 @@ static int Connection_Connect(
     Py_END_ALLOW_THREADS
     if (Environment_CheckForError(self->environment, status,
             "Connection_Connect(): begin session") < 0) {
+        OCIHandleFree(self->sessionHandle, OCI_HTYPE_SESSION);
         self->sessionHandle = NULL;
         return -1;
     }
@@ -796,6 +1053,73 @@ static int Connection_SplitComponent(
 }
 
 
+//-----------------------------------------------------------------------------
+// Connection_CompleteConnect()
+//   Establish a connection which was created lazily, using the arguments
+// retained when it was created. If this fails, any handles allocated are
+// freed and the connection remains pending so that it will be attempted again
+// when the connection is next used. Other threads using the connection wait
+// while the connection is being established since the global interpreter lock
+// is released while doing so.
+//-----------------------------------------------------------------------------
+static int Connection_CompleteConnect(
+    udt_Connection *self)               // connection
+{
+    udt_SessionPool *pool;
+    int result;
+
+    // the pool is set again once the session has been acquired
+    self->connectInProgress = 1;
+    pool = self->sessionPool;
+    self->sessionPool = NULL;
+
+    // establish the connection
+    if (pool || self->deferred.cclassObj)
+        result = Connection_GetConnection(self, pool,
+                self->deferred.cclassObj, self->deferred.purity,
+                self->deferred.tagObj, self->deferred.matchAnyTag);
+    else result = Connection_Connect(self, self->deferred.connectMode,
+            self->deferred.twophase, self->deferred.newPasswordObj);
+
+    // restore the pool if the connection failed, otherwise it is no longer
+    // necessary to retain the arguments
+    if (result < 0) {
+        Connection_FreeSessionHandles(self);
+        if (self->serverHandle) {
+            OCIServerDetach(self->serverHandle,
+                    self->environment->errorHandle, OCI_DEFAULT);
+            OCIHandleFree(self->serverHandle, OCI_HTYPE_SERVER);
+            self->serverHandle = NULL;
+        }
+        if (!self->sessionPool)
+            self->sessionPool = pool;
+        else Py_XDECREF(pool);
+        self->connectInProgress = 0;
+        return -1;
+    }
+    Py_XDECREF(pool);
+    Connection_ClearDeferred(self);
+    self->connectInProgress = 0;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Connection_WaitForConnect()
+//   Wait for another thread which is establishing a lazily created connection
+// to finish doing so.
+//-----------------------------------------------------------------------------
+static void Connection_WaitForConnect(
+    udt_Connection *self)               // connection
+{
+    while (self->connectInProgress) {
+        Py_BEGIN_ALLOW_THREADS
+        SessionPool_Sleep(1);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // Connection_Init()
 //   Initialize the connection members.
@@ -806,8 +1130,9 @@ static int Connection_Init(
     PyObject *keywordArgs)              // keyword arguments
 {
     PyObject *threadedObj, *twophaseObj, *eventsObj, *newPasswordObj;
-    PyObject *usernameObj, *passwordObj, *dsnObj, *cclassObj;
-    int threaded, twophase, events;
+    PyObject *usernameObj, *passwordObj, *dsnObj, *cclassObj, *tagObj;
+    PyObject *matchAnyTagObj, *lazyObj;
+    int threaded, twophase, events, matchAnyTag, lazy;
     char *encoding, *nencoding;
     ub4 connectMode, purity;
     udt_SessionPool *pool;
@@ -816,7 +1141,8 @@ static int Connection_Init(
     // define keyword arguments
     static char *keywordList[] = { "user", "password", "dsn", "mode",
             "handle", "pool", "threaded", "twophase", "events", "cclass",
-            "purity", "newpassword", "encoding", "nencoding", NULL };
+            "purity", "newpassword", "encoding", "nencoding", "tag",
+            "matchanytag", "lazy", NULL };
 
     // parse arguments
     pool = NULL;
@@ -824,16 +1150,18 @@ static int Connection_Init(
     connectMode = OCI_DEFAULT;
     usernameObj = passwordObj = dsnObj = cclassObj = NULL;
     threadedObj = twophaseObj = eventsObj = newPasswordObj = NULL;
-    threaded = twophase = events = purity = 0;
+    tagObj = matchAnyTagObj = lazyObj = NULL;
+    threaded = twophase = events = purity = matchAnyTag = lazy = 0;
     encoding = nencoding = NULL;
 #ifdef ORACLE_11G
     purity = OCI_ATTR_PURITY_DEFAULT;
 #endif
     if (!PyArg_ParseTupleAndKeywords(args, keywordArgs,
-            "|OOOiiO!OOOOiOss", keywordList, &usernameObj, &passwordObj,
+            "|OOOiiO!OOOOiOssOOO", keywordList, &usernameObj, &passwordObj,
             &dsnObj, &connectMode, &handle, &g_SessionPoolType, &pool,
             &threadedObj, &twophaseObj, &eventsObj, &cclassObj, &purity,
-            &newPasswordObj, &encoding, &nencoding))
+            &newPasswordObj, &encoding, &nencoding, &tagObj, &matchAnyTagObj,
+            &lazyObj))
         return -1;
     if (threadedObj) {
         threaded = PyObject_IsTrue(threadedObj);
@@ -850,10 +1178,23 @@ static int Connection_Init(
         if (events < 0)
             return -1;
     }
+    if (matchAnyTagObj) {
+        matchAnyTag = PyObject_IsTrue(matchAnyTagObj);
+        if (matchAnyTag < 0)
+            return -1;
+    }
+    if (lazyObj) {
+        lazy = PyObject_IsTrue(lazyObj);
+        if (lazy < 0)
+            return -1;
+    }
 
     // set up the environment
     if (pool)
         self->environment = Environment_Clone(pool->environment);
+    else if (threaded)
+        self->environment = Environment_NewShared(events, encoding,
+                nencoding);
     else self->environment = Environment_NewFromScratch(threaded, events,
             encoding, nencoding);
     if (!self->environment)
@@ -873,15 +1214,96 @@ static int Connection_Init(
     if (Connection_SplitComponent(&self->password, &self->dsn, "@") < 0)
         return -1;
 
-    // handle the different ways of initializing the connection
+    // handle the different ways of initializing the connection; connecting
+    // lazily defers all but attaching to an existing handle until first use
     if (handle)
         return Connection_Attach(self, handle);
+    if (lazy) {
+        Py_XINCREF(pool);
+        self->sessionPool = pool;
+        self->acquiredFromPool = (pool != NULL);
+        Connection_DeferConnect(self, cclassObj, purity, tagObj, matchAnyTag,
+                connectMode, twophase, newPasswordObj);
+        return 0;
+    }
     if (pool || cclassObj)
-        return Connection_GetConnection(self, pool, cclassObj, purity);
+        return Connection_GetConnection(self, pool, cclassObj, purity, tagObj,
+                matchAnyTag);
     return Connection_Connect(self, connectMode, twophase, newPasswordObj);
 }
 
 
+//-----------------------------------------------------------------------------
+// Connection_TransactionInProgress()
+//   Return a boolean indicating if a transaction may be in progress on the
+// connection so that a rollback is only performed when it is needed. A
+// transaction is assumed to be in progress once a statement has been executed
+// or a transaction started since the last commit or rollback; where the OCI
+// supports it, the session is then asked directly, which does not require a
+// round trip to the server. Errors are ignored and treated as meaning that a
+// transaction is in progress.
+//-----------------------------------------------------------------------------
+static int Connection_TransactionInProgress(
+    udt_Connection *self)               // connection to check
+{
+#ifdef OCI_ATTR_TRANSACTION_IN_PROGRESS
+    OCISession *sessionHandle;
+    boolean inProgress;
+    sword status;
+#endif
+
+    if (!self->transactionInProgress)
+        return 0;
+
+#ifdef OCI_ATTR_TRANSACTION_IN_PROGRESS
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SVCCTX,
+            (dvoid**) &sessionHandle, 0, OCI_ATTR_SESSION,
+            self->environment->errorHandle);
+    if (status != OCI_SUCCESS)
+        return 1;
+    status = OCIAttrGet(sessionHandle, OCI_HTYPE_SESSION, &inProgress, 0,
+            OCI_ATTR_TRANSACTION_IN_PROGRESS, self->environment->errorHandle);
+    if (status != OCI_SUCCESS)
+        return 1;
+    if (!inProgress)
+        self->transactionInProgress = 0;
+    return inProgress ? 1 : 0;
+#else
+    return 1;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Connection_FreeSessionHandles()
+//   Free the service context, transaction and session handles allocated when
+// connecting after the session has been ended or failed to begin. These must
+// be freed explicitly since the environment handle, which would otherwise
+// free them when it is destroyed, may be shared with other connections.
+//-----------------------------------------------------------------------------
+static void Connection_FreeSessionHandles(
+    udt_Connection *self)               // connection
+{
+    OCITrans *transactionHandle;
+    sword status;
+
+    if (self->handle) {
+        transactionHandle = NULL;
+        status = OCIAttrGet(self->handle, OCI_HTYPE_SVCCTX,
+                (dvoid**) &transactionHandle, 0, OCI_ATTR_TRANS,
+                self->environment->errorHandle);
+        if (status == OCI_SUCCESS && transactionHandle)
+            OCIHandleFree(transactionHandle, OCI_HTYPE_TRANS);
+        OCIHandleFree(self->handle, OCI_HTYPE_SVCCTX);
+        self->handle = NULL;
+    }
+    if (self->sessionHandle) {
+        OCIHandleFree(self->sessionHandle, OCI_HTYPE_SESSION);
+        self->sessionHandle = NULL;
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // Connection_Free()
 //   Deallocate the connection, disconnecting from the database if necessary.
@@ -890,26 +1312,32 @@ static void Connection_Free(
     udt_Connection *self)               // connection object
 {
     if (self->release) {
+        if (self->sessionPool)
+            self->sessionPool->stats.releases++;
         Py_BEGIN_ALLOW_THREADS
-        OCITransRollback(self->handle, self->environment->errorHandle,
-                OCI_DEFAULT);
+        if (Connection_TransactionInProgress(self))
+            OCITransRollback(self->handle, self->environment->errorHandle,
+                    OCI_DEFAULT);
         OCISessionRelease(self->handle, self->environment->errorHandle, NULL,
                 0, OCI_DEFAULT);
         Py_END_ALLOW_THREADS
     } else if (!self->attached) {
         if (self->sessionHandle) {
             Py_BEGIN_ALLOW_THREADS
-            OCITransRollback(self->handle, self->environment->errorHandle,
-                    OCI_DEFAULT);
+            if (Connection_TransactionInProgress(self))
+                OCITransRollback(self->handle, self->environment->errorHandle,
+                        OCI_DEFAULT);
             OCISessionEnd(self->handle, self->environment->errorHandle,
                     self->sessionHandle, OCI_DEFAULT);
             Py_END_ALLOW_THREADS
         }
-        if (self->serverHandle)
+        Connection_FreeSessionHandles(self);
+        if (self->serverHandle) {
             OCIServerDetach(self->serverHandle,
                     self->environment->errorHandle, OCI_DEFAULT);
+            OCIHandleFree(self->serverHandle, OCI_HTYPE_SERVER);
+        }
     }
-    Py_CLEAR(self->environment);
     Py_CLEAR(self->sessionPool);
     Py_CLEAR(self->username);
     Py_CLEAR(self->password);
@@ -917,6 +1345,22 @@ static void Connection_Free(
     Py_CLEAR(self->version);
     Py_CLEAR(self->inputTypeHandler);
     Py_CLEAR(self->outputTypeHandler);
+    Py_CLEAR(self->tag);
+    Connection_ClearDeferred(self);
+
+    // place connections of the default type which were acquired from a pool
+    // on the free list, if there is room and nothing else uses the environment;
+    // standalone connections sharing an environment also use a cloned one but
+    // are not placed on the free list since only pools reuse its entries
+    if (Py_TYPE(self) == &g_ConnectionType && self->acquiredFromPool &&
+            self->environment && self->environment->cloneEnv &&
+            Py_REFCNT(self->environment) == 1 &&
+            g_NumFreeConnections < MAX_FREE_CONNECTIONS) {
+        g_FreeConnections[g_NumFreeConnections++] = self;
+        return;
+    }
+
+    Py_CLEAR(self->environment);
     Py_TYPE(self)->tp_free((PyObject*) self);
 }
 
@@ -1036,7 +1480,7 @@ static PyObject *Connection_GetVersion(
     }
 
     // allocate a cursor to retrieve the version
-    cursor = (udt_Cursor*) Connection_NewCursor(self, NULL);
+    cursor = (udt_Cursor*) Connection_NewCursor(self, NULL, NULL);
     if (!cursor)
         return NULL;
 
@@ -1141,18 +1585,29 @@ static PyObject *Connection_Close(
 {
     sword status;
 
+    // a connection which has not yet been established is simply abandoned
+    Connection_WaitForConnect(self);
+    if (self->connectPending) {
+        Connection_ClearDeferred(self);
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
     // make sure we are actually connected
     if (Connection_IsConnected(self) < 0)
         return NULL;
 
-    // perform a rollback
-    Py_BEGIN_ALLOW_THREADS
-    status = OCITransRollback(self->handle, self->environment->errorHandle,
-            OCI_DEFAULT);
-    Py_END_ALLOW_THREADS
-    if (Environment_CheckForError(self->environment, status,
-            "Connection_Close(): rollback") < 0)
-        return NULL;
+    // perform a rollback, if needed
+    if (Connection_TransactionInProgress(self)) {
+        Py_BEGIN_ALLOW_THREADS
+        status = OCITransRollback(self->handle,
+                self->environment->errorHandle, OCI_DEFAULT);
+        Py_END_ALLOW_THREADS
+        if (Environment_CheckForError(self->environment, status,
+                "Connection_Close(): rollback") < 0)
+            return NULL;
+        self->transactionInProgress = 0;
+    }
 
     // logoff of the server
     if (self->sessionHandle) {
@@ -1163,7 +1618,7 @@ static PyObject *Connection_Close(
         if (Environment_CheckForError(self->environment, status,
                 "Connection_Close(): end session") < 0)
             return NULL;
-        OCIHandleFree(self->handle, OCI_HTYPE_SVCCTX);
+        Connection_FreeSessionHandles(self);
     }
     self->handle = NULL;
     if (self->serverHandle) {
@@ -1172,6 +1627,7 @@ static PyObject *Connection_Close(
         if (Environment_CheckForError(self->environment, status,
                 "Connection_Close(): server detach") < 0)
             return NULL;
+        OCIHandleFree(self->serverHandle, OCI_HTYPE_SERVER);
         self->serverHandle = NULL;
     }
 
@@ -1190,6 +1646,13 @@ static PyObject *Connection_Commit(
 {
     sword status;
 
+    // a connection which has not yet been established has nothing to commit
+    Connection_WaitForConnect(self);
+    if (self->connectPending) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
     // make sure we are actually connected
     if (Connection_IsConnected(self) < 0)
         return NULL;
@@ -1203,6 +1666,7 @@ static PyObject *Connection_Commit(
             "Connection_Commit()") < 0)
         return NULL;
     self->commitMode = OCI_DEFAULT;
+    self->transactionInProgress = 0;
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1291,6 +1755,7 @@ static PyObject *Connection_Begin(
     if (Environment_CheckForError(self->environment, status,
             "Connection_Begin(): start transaction") < 0)
         return NULL;
+    self->transactionInProgress = 1;
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1343,6 +1808,13 @@ static PyObject *Connection_Rollback(
 {
     sword status;
 
+    // a connection which has not yet been established has nothing to roll back
+    Connection_WaitForConnect(self);
+    if (self->connectPending) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
     // make sure we are actually connected
     if (Connection_IsConnected(self) < 0)
         return NULL;
@@ -1355,6 +1827,7 @@ static PyObject *Connection_Rollback(
     if (Environment_CheckForError(self->environment, status,
             "Connection_Rollback()") < 0)
         return NULL;
+    self->transactionInProgress = 0;
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1367,15 +1840,25 @@ static PyObject *Connection_Rollback(
 //-----------------------------------------------------------------------------
 static PyObject *Connection_NewCursor(
     udt_Connection *self,               // connection to create cursor on
-    PyObject *args)                     // arguments
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
 {
+    static char *keywordList[] = { "scrollable", NULL };
     PyObject *createArgs, *result;
+    int scrollable;
 
-    createArgs = PyTuple_New(1);
+    // parse arguments; internal callers pass no arguments at all
+    scrollable = 0;
+    if (args && !PyArg_ParseTupleAndKeywords(args, keywordArgs, "|i",
+            keywordList, &scrollable))
+        return NULL;
+
+    createArgs = PyTuple_New(2);
     if (!createArgs)
         return NULL;
     Py_INCREF(self);
     PyTuple_SET_ITEM(createArgs, 0, (PyObject*) self);
+    PyTuple_SET_ITEM(createArgs, 1, PyBool_FromLong(scrollable));
     result = PyObject_Call( (PyObject*) &g_CursorType, createArgs, NULL);
     Py_DECREF(createArgs);
     return result;
@@ -1393,6 +1876,13 @@ static PyObject *Connection_Cancel(
 {
     sword status;
 
+    // a connection which has not yet been established has nothing to cancel
+    Connection_WaitForConnect(self);
+    if (self->connectPending) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
     // make sure we are actually connected
     if (Connection_IsConnected(self) < 0)
         return NULL;
@@ -1519,6 +2009,11 @@ static PyObject *Connection_ContextManagerExit(
 
     if (!PyArg_ParseTuple(args, "OOO", &excType, &excValue, &excTraceback))
         return NULL;
+    Connection_WaitForConnect(self);
+    if (self->connectPending) {
+        Py_INCREF(Py_False);
+        return Py_False;
+    }
     if (excType == Py_None && excValue == Py_None && excTraceback == Py_None)
         methodName = "commit";
     else methodName = "rollback";
@@ -1670,6 +2165,10 @@ static PyObject *Connection_Subscribe(
             &rowidsObj, &port))
         return NULL;
 
+    // make sure we are actually connected
+    if (Connection_IsConnected(self) < 0)
+        return NULL;
+
     // set the value for rowids
     if (rowidsObj) {
         temp = PyObject_IsTrue(rowidsObj);
@@ -22,6 +22,10 @@ typedef struct {
     int bindArraySize;
     int fetchArraySize;
     int numbersAsStrings;
+    int numbersAsNativeFloats;
+    int timestampsAsEpoch;
+    int dynamicLongs;
+    int stringDefineSize;
     int setInputSizes;
     int outputSize;
     int outputSizeColumn;
@@ -32,13 +36,29 @@ typedef struct {
     int isDML;
     int isOpen;
     int isOwned;
+    int isScrollable;
+    int generation;
 } udt_Cursor;
 
 
+//-----------------------------------------------------------------------------
+// structure for the Python type "CursorIterator"; the generation of the
+// cursor is incremented whenever it is prepared, executed or closed so that
+// the iterator only needs to validate the cursor again when it changes
+//-----------------------------------------------------------------------------
+typedef struct {
+    PyObject_HEAD
+    udt_Cursor *cursor;
+    int generation;
+} udt_CursorIterator;
+
+
 //-----------------------------------------------------------------------------
 // dependent function defintions
 //-----------------------------------------------------------------------------
 static void Cursor_Free(udt_Cursor*);
+static void CursorIterator_Free(udt_CursorIterator*);
+static PyObject *CursorIterator_GetNext(udt_CursorIterator*);
 
 
 //-----------------------------------------------------------------------------
@@ -50,12 +70,19 @@ static PyObject *Cursor_Close(udt_Cursor*, PyObject*);
 static PyObject *Cursor_CallFunc(udt_Cursor*, PyObject*, PyObject*);
 static PyObject *Cursor_CallProc(udt_Cursor*, PyObject*, PyObject*);
 static PyObject *Cursor_Execute(udt_Cursor*, PyObject*, PyObject*);
+static PyObject *Cursor_FetchSingle(udt_Cursor*, PyObject*, PyObject*);
 static PyObject *Cursor_ExecuteMany(udt_Cursor*, PyObject*);
 static PyObject *Cursor_ExecuteManyPrepared(udt_Cursor*, PyObject*);
 static PyObject *Cursor_FetchOne(udt_Cursor*, PyObject*);
 static PyObject *Cursor_FetchMany(udt_Cursor*, PyObject*, PyObject*);
-static PyObject *Cursor_FetchAll(udt_Cursor*, PyObject*);
+static PyObject *Cursor_FetchAll(udt_Cursor*, PyObject*, PyObject*);
 static PyObject *Cursor_FetchRaw(udt_Cursor*, PyObject*, PyObject*);
+static PyObject *Cursor_Aggregate(udt_Cursor*, PyObject*, PyObject*);
+static PyObject *Cursor_CopyFrom(udt_Cursor*, PyObject*, PyObject*);
+#if PY_VERSION_HEX >= 0x02060000
+static PyObject *Cursor_FetchInto(udt_Cursor*, PyObject*, PyObject*);
+#endif
+static PyObject *Cursor_Scroll(udt_Cursor*, PyObject*, PyObject*);
 static PyObject *Cursor_Parse(udt_Cursor*, PyObject*);
 static PyObject *Cursor_Prepare(udt_Cursor*, PyObject*);
 static PyObject *Cursor_SetInputSizes(udt_Cursor*, PyObject*, PyObject*);
@@ -74,12 +101,24 @@ static PyObject *Cursor_Repr(udt_Cursor*);
 //-----------------------------------------------------------------------------
 static PyMethodDef g_CursorMethods[] = {
     { "execute", (PyCFunction) Cursor_Execute, METH_VARARGS | METH_KEYWORDS },
-    { "fetchall", (PyCFunction) Cursor_FetchAll, METH_NOARGS },
+    { "fetchall", (PyCFunction) Cursor_FetchAll,
+              METH_VARARGS | METH_KEYWORDS },
     { "fetchone", (PyCFunction) Cursor_FetchOne, METH_NOARGS },
+    { "fetchsingle", (PyCFunction) Cursor_FetchSingle,
+              METH_VARARGS | METH_KEYWORDS },
     { "fetchmany", (PyCFunction) Cursor_FetchMany,
               METH_VARARGS | METH_KEYWORDS },
     { "fetchraw", (PyCFunction) Cursor_FetchRaw,
               METH_VARARGS | METH_KEYWORDS },
+#if PY_VERSION_HEX >= 0x02060000
+    { "fetchinto", (PyCFunction) Cursor_FetchInto,
+              METH_VARARGS | METH_KEYWORDS },
+#endif
+    { "scroll", (PyCFunction) Cursor_Scroll, METH_VARARGS | METH_KEYWORDS },
+    { "aggregate", (PyCFunction) Cursor_Aggregate,
+              METH_VARARGS | METH_KEYWORDS },
+    { "copyfrom", (PyCFunction) Cursor_CopyFrom,
+              METH_VARARGS | METH_KEYWORDS },
     { "prepare", (PyCFunction) Cursor_Prepare, METH_VARARGS },
     { "parse", (PyCFunction) Cursor_Parse, METH_VARARGS },
     { "setinputsizes", (PyCFunction) Cursor_SetInputSizes,
@@ -109,7 +148,15 @@ static PyMemberDef g_CursorMembers[] = {
     { "rowcount", T_INT, offsetof(udt_Cursor, rowCount), READONLY },
     { "statement", T_OBJECT, offsetof(udt_Cursor, statement), READONLY },
     { "connection", T_OBJECT_EX, offsetof(udt_Cursor, connection), READONLY },
+    { "scrollable", T_INT, offsetof(udt_Cursor, isScrollable), READONLY },
     { "numbersAsStrings", T_INT, offsetof(udt_Cursor, numbersAsStrings), 0 },
+    { "numbersAsNativeFloats", T_INT,
+            offsetof(udt_Cursor, numbersAsNativeFloats), 0 },
+    { "timestampsAsEpoch", T_INT, offsetof(udt_Cursor, timestampsAsEpoch),
+            0 },
+    { "dynamicLongs", T_INT, offsetof(udt_Cursor, dynamicLongs), 0 },
+    { "stringDefineSize", T_INT, offsetof(udt_Cursor, stringDefineSize),
+            0 },
     { "rowfactory", T_OBJECT, offsetof(udt_Cursor, rowFactory), 0 },
     { "bindvars", T_OBJECT, offsetof(udt_Cursor, bindVariables), READONLY },
     { "fetchvars", T_OBJECT, offsetof(udt_Cursor, fetchVariables), READONLY },
@@ -179,6 +226,55 @@ static PyTypeObject g_CursorType = {
 };
 
 
+//-----------------------------------------------------------------------------
+// declaration of Python type "CursorIterator"
+//-----------------------------------------------------------------------------
+static PyTypeObject g_CursorIteratorType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "cx_Oracle.CursorIterator",         // tp_name
+    sizeof(udt_CursorIterator),         // tp_basicsize
+    0,                                  // tp_itemsize
+    (destructor) CursorIterator_Free,   // tp_dealloc
+    0,                                  // tp_print
+    0,                                  // tp_getattr
+    0,                                  // tp_setattr
+    0,                                  // tp_compare
+    0,                                  // tp_repr
+    0,                                  // tp_as_number
+    0,                                  // tp_as_sequence
+    0,                                  // tp_as_mapping
+    0,                                  // tp_hash
+    0,                                  // tp_call
+    0,                                  // tp_str
+    0,                                  // tp_getattro
+    0,                                  // tp_setattro
+    0,                                  // tp_as_buffer
+    Py_TPFLAGS_DEFAULT,                 // tp_flags
+    0,                                  // tp_doc
+    0,                                  // tp_traverse
+    0,                                  // tp_clear
+    0,                                  // tp_richcompare
+    0,                                  // tp_weaklistoffset
+    PyObject_SelfIter,                  // tp_iter
+    (iternextfunc) CursorIterator_GetNext,
+                                        // tp_iternext
+    0,                                  // tp_methods
+    0,                                  // tp_members
+    0,                                  // tp_getset
+    0,                                  // tp_base
+    0,                                  // tp_dict
+    0,                                  // tp_descr_get
+    0,                                  // tp_descr_set
+    0,                                  // tp_dictoffset
+    0,                                  // tp_init
+    0,                                  // tp_alloc
+    0,                                  // tp_new
+    0,                                  // tp_free
+    0,                                  // tp_is_gc
+    0                                   // tp_bases
+};
+
+
 //-----------------------------------------------------------------------------
 // Cursor_AllocateHandle()
 //   Allocate a new handle.
@@ -236,6 +332,21 @@ static int Cursor_FreeHandle(
 #include "Variable.c"
 
 
+//-----------------------------------------------------------------------------
+// structure used while computing aggregates with Cursor.aggregate()
+//-----------------------------------------------------------------------------
+typedef struct {
+    int numItems;
+    int *functions;
+    int *columns;
+    udt_Variable *groupVar;
+    PyObject *groups;
+    udt_AggregateValue *values;
+    int numGroups;
+    int allocatedGroups;
+} udt_AggregateState;
+
+
 //-----------------------------------------------------------------------------
 // Cursor_IsOpen()
 //   Determines if the cursor object is open and if so, if the connection is
@@ -274,16 +385,30 @@ static int Cursor_Init(
     PyObject *args,                     // arguments
     PyObject *keywordArgs)              // keyword arguments
 {
+    static char *keywordList[] = { "connection", "scrollable", NULL };
     udt_Connection *connection;
+    int scrollable;
 
     // parse arguments
-    if (!PyArg_ParseTuple(args, "O!", &g_ConnectionType, &connection))
+    scrollable = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O!|i", keywordList,
+            &g_ConnectionType, &connection, &scrollable))
         return -1;
 
+    // in threaded mode, each cursor gets its own error handle so that cursors
+    // used concurrently from different threads do not share error state
+    if (connection->environment->threaded) {
+        self->environment = Environment_Clone(connection->environment);
+        if (!self->environment)
+            return -1;
+    } else {
+        Py_INCREF(connection->environment);
+        self->environment = connection->environment;
+    }
+
     // initialize members
     Py_INCREF(connection);
     self->connection = connection;
-    self->environment = connection->environment;
     self->arraySize = 50;
     self->fetchArraySize = 50;
     self->bindArraySize = 1;
@@ -291,6 +416,7 @@ static int Cursor_Init(
     self->outputSize = -1;
     self->outputSizeColumn = -1;
     self->isOpen = 1;
+    self->isScrollable = scrollable;
 
     return 0;
 }
@@ -346,6 +472,7 @@ static void Cursor_Free(
     Py_CLEAR(self->bindVariables);
     Py_CLEAR(self->fetchVariables);
     Py_CLEAR(self->connection);
+    Py_CLEAR(self->environment);
     Py_CLEAR(self->rowFactory);
     Py_CLEAR(self->inputTypeHandler);
     Py_CLEAR(self->outputTypeHandler);
@@ -457,7 +584,8 @@ static int Cursor_GetBindNames(
 // statement being executed is in fact a query.
 //-----------------------------------------------------------------------------
 static int Cursor_PerformDefine(
-    udt_Cursor *self)                   // cursor to perform define on
+    udt_Cursor *self,                   // cursor to perform define on
+    int numRows)                        // number of rows to define
 {
     int numParams, pos;
     udt_Variable *var;
@@ -476,7 +604,7 @@ static int Cursor_PerformDefine(
         return -1;
 
     // define a variable for each select-item
-    self->fetchArraySize = self->arraySize;
+    self->fetchArraySize = numRows;
     for (pos = 1; pos <= numParams; pos++) {
         var = Variable_Define(self, self->fetchArraySize, pos);
         if (!var)
@@ -539,26 +667,59 @@ static void Cursor_SetErrorOffset(
 }
 
 
+//-----------------------------------------------------------------------------
+// Cursor_PreFetch()
+//   Prepare the fetch variables for a fetch, which may take place as part of
+// an execute as well as during an explicit fetch.
+//-----------------------------------------------------------------------------
+static int Cursor_PreFetch(
+    udt_Cursor *self)                   // cursor about to fetch
+{
+    udt_Variable *var;
+    int i;
+
+    for (i = 0; i < PyList_GET_SIZE(self->fetchVariables); i++) {
+        var = (udt_Variable*) PyList_GET_ITEM(self->fetchVariables, i);
+        var->internalFetchNum++;
+        if (var->type->preFetchProc) {
+            if ((*var->type->preFetchProc)(var) < 0)
+                return -1;
+        }
+    }
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // Cursor_InternalExecute()
 //   Perform the work of executing a cursor and set the rowcount appropriately
-// regardless of whether an error takes place.
+// regardless of whether an error takes place. For queries, a non-zero number
+// of iterations fetches that many rows into the fetch variables, which must
+// already have been defined.
 //-----------------------------------------------------------------------------
 static int Cursor_InternalExecute(
     udt_Cursor *self,                   // cursor to perform the execute on
-    ub4 numIters)                       // number of iterations to execute
+    ub4 numIters,                       // number of iterations to execute
+    ub4 mode)                           // additional mode flags
 {
+    ub4 rowCount;
     sword status;
-    ub4 mode;
 
+    self->generation++;
     if (self->connection->autocommit)
-        mode = OCI_COMMIT_ON_SUCCESS;
-    else mode = OCI_DEFAULT;
+        mode |= OCI_COMMIT_ON_SUCCESS;
+    if (self->isScrollable && self->statementType == OCI_STMT_SELECT)
+        mode |= OCI_STMT_SCROLLABLE_READONLY;
+    if (!(mode & OCI_DESCRIBE_ONLY))
+        self->connection->transactionInProgress = 1;
 
     Py_BEGIN_ALLOW_THREADS
     status = OCIStmtExecute(self->connection->handle, self->handle,
             self->environment->errorHandle, numIters, 0, 0, 0, mode);
     Py_END_ALLOW_THREADS
+    if (status == OCI_NO_DATA && self->statementType == OCI_STMT_SELECT)
+        status = OCI_SUCCESS;
     if (Environment_CheckForError(self->environment, status,
             "Cursor_InternalExecute()") < 0) {
         Cursor_SetErrorOffset(self);
@@ -566,7 +727,20 @@ static int Cursor_InternalExecute(
             PyErr_Clear();
         return -1;
     }
-    return Cursor_SetRowCount(self);
+    if (Cursor_SetRowCount(self) < 0)
+        return -1;
+
+    // rows fetched as part of the execute are available immediately
+    if (self->statementType == OCI_STMT_SELECT && numIters > 0) {
+        status = OCIAttrGet(self->handle, OCI_HTYPE_STMT, &rowCount, 0,
+                OCI_ATTR_ROW_COUNT, self->environment->errorHandle);
+        if (Environment_CheckForError(self->environment, status,
+                "Cursor_InternalExecute(): row count") < 0)
+            return -1;
+        self->actualRows = rowCount;
+    }
+
+    return 0;
 }
 
 
@@ -587,6 +761,7 @@ static int Cursor_GetStatementType(
             "Cursor_GetStatementType()") < 0)
         return -1;
     self->statementType = statementType;
+    self->generation++;
     if (self->fetchVariables) {
         Py_DECREF(self->fetchVariables);
         self->fetchVariables = NULL;
@@ -608,7 +783,7 @@ static int Cursor_FixupBoundCursor(
         if (Cursor_GetStatementType(self) < 0)
             return -1;
         if (self->statementType == OCI_STMT_SELECT &&
-                Cursor_PerformDefine(self) < 0)
+                Cursor_PerformDefine(self, self->arraySize) < 0)
             return -1;
         if (Cursor_SetRowCount(self) < 0)
             return -1;
@@ -840,6 +1015,7 @@ static PyObject *Cursor_Close(
         return NULL;
 
     self->isOpen = 0;
+    self->generation++;
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1584,39 +1760,60 @@ static PyObject *Cursor_CallProc(
 
 
 //-----------------------------------------------------------------------------
-// Cursor_Execute()
-//   Execute the statement.
+// Cursor_ParseExecuteArgs()
+//   Parse the arguments passed to execute() and fetchsingle(), which consist
+// of the statement and either a sequence or dictionary of parameters or
+// keyword parameters.
 //-----------------------------------------------------------------------------
-static PyObject *Cursor_Execute(
-    udt_Cursor *self,                   // cursor to execute
+static int Cursor_ParseExecuteArgs(
     PyObject *args,                     // arguments
-    PyObject *keywordArgs)              // keywords
+    PyObject *keywordArgs,              // keyword arguments
+    PyObject **statement,               // statement to execute (OUT)
+    PyObject **executeArgs)             // parameters, if any (OUT)
 {
-    PyObject *statement, *executeArgs;
-    int isQuery;
-
-    executeArgs = NULL;
-    if (!PyArg_ParseTuple(args, "O|O", &statement, &executeArgs))
-        return NULL;
-    if (executeArgs && keywordArgs) {
+    *executeArgs = NULL;
+    if (!PyArg_ParseTuple(args, "O|O", statement, executeArgs))
+        return -1;
+    if (*executeArgs && keywordArgs) {
         if (PyDict_Size(keywordArgs) == 0)
             keywordArgs = NULL;
         else {
             PyErr_SetString(g_InterfaceErrorException,
                     "expecting argument or keyword arguments, not both");
-            return NULL;
+            return -1;
         }
     }
     if (keywordArgs)
-        executeArgs = keywordArgs;
-    if (executeArgs) {
-        if (!PyDict_Check(executeArgs) && !PySequence_Check(executeArgs)) {
+        *executeArgs = keywordArgs;
+    if (*executeArgs) {
+        if (!PyDict_Check(*executeArgs) && !PySequence_Check(*executeArgs)) {
             PyErr_SetString(PyExc_TypeError,
                     "expecting a dictionary, sequence or keyword args");
-            return NULL;
+            return -1;
         }
     }
 
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_Execute()
+//   Execute the statement.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_Execute(
+    udt_Cursor *self,                   // cursor to execute
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keywords
+{
+    PyObject *statement, *executeArgs;
+    int isQuery;
+    ub4 numIters;
+
+    if (Cursor_ParseExecuteArgs(args, keywordArgs, &statement,
+            &executeArgs) < 0)
+        return NULL;
+
     // make sure the cursor is open
     if (Cursor_IsOpen(self) < 0)
         return NULL;
@@ -1632,13 +1829,32 @@ static PyObject *Cursor_Execute(
     if (Cursor_PerformBind(self) < 0)
         return NULL;
 
-    // execute the statement
+    // execute the statement; a query that was defined by a previous execute
+    // of the same statement retrieves its first batch of rows as part of the
+    // execute, which saves a round trip
     isQuery = (self->statementType == OCI_STMT_SELECT);
-    if (Cursor_InternalExecute(self, isQuery ? 0 : 1) < 0)
+    numIters = 1;
+    if (isQuery) {
+        numIters = 0;
+
+        // variables defined by fetchsingle() only hold a single row so they
+        // are replaced rather than fetching one row per round trip
+        if (self->fetchVariables && self->fetchArraySize < self->arraySize) {
+            Py_DECREF(self->fetchVariables);
+            self->fetchVariables = NULL;
+        }
+        if (self->fetchVariables && !self->isScrollable) {
+            if (Cursor_PreFetch(self) < 0)
+                return NULL;
+            numIters = self->fetchArraySize;
+        }
+    }
+    if (Cursor_InternalExecute(self, numIters, OCI_DEFAULT) < 0)
         return NULL;
 
     // perform defines, if necessary
-    if (isQuery && !self->fetchVariables && Cursor_PerformDefine(self) < 0)
+    if (isQuery && !self->fetchVariables &&
+            Cursor_PerformDefine(self, self->arraySize) < 0)
         return NULL;
 
     // reset the values of setoutputsize()
@@ -1657,6 +1873,79 @@ static PyObject *Cursor_Execute(
 }
 
 
+//-----------------------------------------------------------------------------
+// Cursor_FetchSingle()
+//   Execute a query that is expected to return at most one row and return
+// that row or None if no row is found. The row is fetched as part of the
+// execute using an exact fetch so that Oracle raises an error if more than one
+// row is returned by the query.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_FetchSingle(
+    udt_Cursor *self,                   // cursor to execute
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keywords
+{
+    PyObject *statement, *executeArgs, *row;
+    sword status;
+
+    if (Cursor_ParseExecuteArgs(args, keywordArgs, &statement,
+            &executeArgs) < 0)
+        return NULL;
+
+    // make sure the cursor is open
+    if (Cursor_IsOpen(self) < 0)
+        return NULL;
+
+    // prepare the statement, if applicable
+    if (Cursor_InternalPrepare(self, statement, NULL) < 0)
+        return NULL;
+    if (self->statementType != OCI_STMT_SELECT) {
+        PyErr_SetString(g_InterfaceErrorException, "not a query");
+        return NULL;
+    }
+
+    // perform binds
+    if (executeArgs && Cursor_SetBindVariables(self, executeArgs, 1, 0,
+            0) < 0)
+        return NULL;
+    if (Cursor_PerformBind(self) < 0)
+        return NULL;
+
+    // the defines must be in place before the execute; a describe is only
+    // needed the first time the statement is executed
+    if (!self->fetchVariables) {
+        Py_BEGIN_ALLOW_THREADS
+        status = OCIStmtExecute(self->connection->handle, self->handle,
+                self->environment->errorHandle, 0, 0, 0, 0,
+                OCI_DESCRIBE_ONLY);
+        Py_END_ALLOW_THREADS
+        if (Environment_CheckForError(self->environment, status,
+                "Cursor_FetchSingle(): describe") < 0)
+            return NULL;
+        if (Cursor_PerformDefine(self, 1) < 0)
+            return NULL;
+    }
+    self->outputSize = -1;
+    self->outputSizeColumn = -1;
+
+    // execute the statement and fetch the row at the same time
+    if (Cursor_PreFetch(self) < 0)
+        return NULL;
+    if (Cursor_InternalExecute(self, 1, OCI_EXACT_FETCH) < 0)
+        return NULL;
+
+    if (self->actualRows == 0) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    row = Cursor_CreateRow(self);
+
+    // an exact fetch cancels the cursor so no further rows are available
+    self->actualRows = 0;
+    return row;
+}
+
+
 //-----------------------------------------------------------------------------
 // Cursor_ExecuteMany()
 //   Execute the statement many times. The number of times is equivalent to the
@@ -1708,7 +1997,7 @@ static PyObject *Cursor_ExecuteMany(
     // execute the statement, but only if the number of rows is greater than
     // zero since Oracle raises an error otherwise
     if (numRows > 0) {
-        if (Cursor_InternalExecute(self, numRows) < 0)
+        if (Cursor_InternalExecute(self, numRows, OCI_DEFAULT) < 0)
             return NULL;
     }
 
@@ -1754,7 +2043,7 @@ static PyObject *Cursor_ExecuteManyPrepared(
         return NULL;
 
     // execute the statement
-    if (Cursor_InternalExecute(self, numIters) < 0)
+    if (Cursor_InternalExecute(self, numIters, OCI_DEFAULT) < 0)
         return NULL;
 
     Py_INCREF(Py_None);
@@ -1789,44 +2078,53 @@ static int Cursor_VerifyFetch(
 
 //-----------------------------------------------------------------------------
 // Cursor_InternalFetch()
-//   Performs the actual fetch from Oracle.
+//   Performs the actual fetch from Oracle. The orientation and offset are
+// passed through to OCIStmtFetch2() and are only meaningful for scrollable
+// cursors; all other fetches use OCI_FETCH_NEXT.
 //-----------------------------------------------------------------------------
 static int Cursor_InternalFetch(
     udt_Cursor *self,                   // cursor to fetch from
-    int numRows)                        // number of rows to fetch
+    int numRows,                        // number of rows to fetch
+    ub2 orientation,                    // fetch orientation
+    sb4 offset)                         // offset for the orientation
 {
-    udt_Variable *var;
     sword status;
     ub4 rowCount;
-    int i;
 
     if (!self->fetchVariables) {
         PyErr_SetString(g_InterfaceErrorException, "query not executed");
         return -1;
     }
-    for (i = 0; i < PyList_GET_SIZE(self->fetchVariables); i++) {
-        var = (udt_Variable*) PyList_GET_ITEM(self->fetchVariables, i);
-        var->internalFetchNum++;
-        if (var->type->preFetchProc) {
-            if ((*var->type->preFetchProc)(var) < 0)
-                return -1;
-        }
-    }
+    if (Cursor_PreFetch(self) < 0)
+        return -1;
     Py_BEGIN_ALLOW_THREADS
-    status = OCIStmtFetch(self->handle, self->environment->errorHandle,
-            numRows, OCI_FETCH_NEXT, OCI_DEFAULT);
+    status = OCIStmtFetch2(self->handle, self->environment->errorHandle,
+            numRows, orientation, offset, OCI_DEFAULT);
     Py_END_ALLOW_THREADS
     if (status != OCI_NO_DATA) {
         if (Environment_CheckForError(self->environment, status,
                 "Cursor_InternalFetch(): fetch") < 0)
             return -1;
     }
-    status = OCIAttrGet(self->handle, OCI_HTYPE_STMT, &rowCount, 0,
-            OCI_ATTR_ROW_COUNT, self->environment->errorHandle);
-    if (Environment_CheckForError(self->environment, status,
-            "Cursor_InternalFetch(): row count") < 0)
-        return -1;
-    self->actualRows = rowCount - self->rowCount;
+
+    // the row count of a scrollable cursor is the highest row fetched so far
+    // rather than a running total so the rows in the buffer are acquired
+    // directly instead
+    if (self->isScrollable) {
+        status = OCIAttrGet(self->handle, OCI_HTYPE_STMT, &rowCount, 0,
+                OCI_ATTR_ROWS_FETCHED, self->environment->errorHandle);
+        if (Environment_CheckForError(self->environment, status,
+                "Cursor_InternalFetch(): rows fetched") < 0)
+            return -1;
+        self->actualRows = rowCount;
+    } else {
+        status = OCIAttrGet(self->handle, OCI_HTYPE_STMT, &rowCount, 0,
+                OCI_ATTR_ROW_COUNT, self->environment->errorHandle);
+        if (Environment_CheckForError(self->environment, status,
+                "Cursor_InternalFetch(): row count") < 0)
+            return -1;
+        self->actualRows = rowCount - self->rowCount;
+    }
     self->rowNum = 0;
     return 0;
 }
@@ -1841,8 +2139,16 @@ static int Cursor_MoreRows(
     udt_Cursor *self)                   // cursor to fetch from
 {
     if (self->rowNum >= self->actualRows) {
-        if (self->actualRows < 0 || self->actualRows == self->fetchArraySize) {
-            if (Cursor_InternalFetch(self, self->fetchArraySize) < 0)
+        // a scrollable cursor whose buffer was invalidated by a failed scroll
+        // is not necessarily positioned after the last row returned
+        if (self->isScrollable && self->actualRows < 0) {
+            if (Cursor_InternalFetch(self, self->fetchArraySize,
+                    OCI_FETCH_ABSOLUTE, self->rowCount + 1) < 0)
+                return -1;
+        } else if (self->actualRows < 0 ||
+                self->actualRows == self->fetchArraySize) {
+            if (Cursor_InternalFetch(self, self->fetchArraySize,
+                    OCI_FETCH_NEXT, 0) < 0)
                 return -1;
         }
         if (self->rowNum >= self->actualRows)
@@ -1855,19 +2161,35 @@ static int Cursor_MoreRows(
 //-----------------------------------------------------------------------------
 // Cursor_MultiFetch()
 //   Return a list consisting of the remaining rows up to the given row limit
-// (if specified).
+// (if specified). The rows are appended to the given list, if one is
+// specified; otherwise, a new list is created. When a row limit is specified
+// the new list is allocated at that size up front, filled directly and
+// trimmed if fewer rows remain; otherwise the final size is not known so the
+// rows are appended one at a time.
 //-----------------------------------------------------------------------------
 static PyObject *Cursor_MultiFetch(
     udt_Cursor *self,                   // cursor to fetch from
-    int rowLimit)                       // row limit
+    int rowLimit,                       // row limit
+    PyObject *into)                     // list to append rows to (optional)
 {
+    int rowNum, status, preallocated;
     PyObject *results, *row;
-    int rowNum, status;
 
-    // create an empty list
-    results = PyList_New(0);
-    if (!results)
-        return NULL;
+    // append to the list passed in or create a new list
+    preallocated = 0;
+    if (into) {
+        results = into;
+        Py_INCREF(results);
+    } else if (rowLimit > 0) {
+        results = PyList_New(rowLimit);
+        if (!results)
+            return NULL;
+        preallocated = 1;
+    } else {
+        results = PyList_New(0);
+        if (!results)
+            return NULL;
+    }
 
     // fetch as many rows as possible
     for (rowNum = 0; rowLimit == 0 || rowNum < rowLimit; rowNum++) {
@@ -1883,12 +2205,24 @@ static PyObject *Cursor_MultiFetch(
                 Py_DECREF(results);
                 return NULL;
             }
-            if (PyList_Append(results, row) < 0) {
+            if (preallocated) {
+                PyList_SET_ITEM(results, rowNum, row);
+            } else {
+                if (PyList_Append(results, row) < 0) {
+                    Py_DECREF(row);
+                    Py_DECREF(results);
+                    return NULL;
+                }
                 Py_DECREF(row);
-                Py_DECREF(results);
-                return NULL;
             }
-            Py_DECREF(row);
+        }
+    }
+
+    // remove the unused entries of a preallocated list
+    if (preallocated && rowNum < rowLimit) {
+        if (PyList_SetSlice(results, rowNum, rowLimit, NULL) < 0) {
+            Py_DECREF(results);
+            return NULL;
         }
     }
 
@@ -1931,20 +2265,22 @@ static PyObject *Cursor_FetchMany(
     PyObject *args,                     // arguments
     PyObject *keywordArgs)              // keyword arguments
 {
-    static char *keywordList[] = { "numRows", NULL };
+    static char *keywordList[] = { "numRows", "into", NULL };
+    PyObject *into;
     int rowLimit;
 
-    // parse arguments -- optional rowlimit expected
+    // parse arguments -- optional rowlimit and list to append to expected
     rowLimit = self->arraySize;
-    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|i", keywordList,
-            &rowLimit))
+    into = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|iO!", keywordList,
+            &rowLimit, &PyList_Type, &into))
         return NULL;
 
     // verify fetch can be performed
     if (Cursor_VerifyFetch(self) < 0)
         return NULL;
 
-    return Cursor_MultiFetch(self, rowLimit);
+    return Cursor_MultiFetch(self, rowLimit, into);
 }
 
 
@@ -1954,11 +2290,21 @@ static PyObject *Cursor_FetchMany(
 //-----------------------------------------------------------------------------
 static PyObject *Cursor_FetchAll(
     udt_Cursor *self,                   // cursor to fetch from
-    PyObject *args)                     // arguments
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
 {
+    static char *keywordList[] = { "into", NULL };
+    PyObject *into;
+
+    // parse arguments -- optional list to append to expected
+    into = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|O!", keywordList,
+            &PyList_Type, &into))
+        return NULL;
+
     if (Cursor_VerifyFetch(self) < 0)
         return NULL;
-    return Cursor_MultiFetch(self, 0);
+    return Cursor_MultiFetch(self, 0, into);
 }
 
 
@@ -1985,12 +2331,21 @@ static PyObject *Cursor_FetchRaw(
         return NULL;
     }
 
+    // rows fetched as part of the execute are already in the buffers
+    if (self->rowCount == 0 && self->rowNum == 0 && self->actualRows >= 0) {
+        self->rowCount = self->actualRows;
+        numRowsFetched = self->actualRows;
+        if (self->actualRows == self->fetchArraySize)
+            self->actualRows = -1;
+        return PyInt_FromLong(numRowsFetched);
+    }
+
     // do not attempt to perform fetch if no more rows to fetch
     if (self->actualRows > 0 && self->actualRows < self->fetchArraySize)
         return PyInt_FromLong(0);
 
     // perform internal fetch
-    if (Cursor_InternalFetch(self, numRowsToFetch) < 0)
+    if (Cursor_InternalFetch(self, numRowsToFetch, OCI_FETCH_NEXT, 0) < 0)
         return NULL;
 
     self->rowCount += self->actualRows;
@@ -2001,37 +2356,807 @@ static PyObject *Cursor_FetchRaw(
 }
 
 
+#if PY_VERSION_HEX >= 0x02060000
 //-----------------------------------------------------------------------------
-// Cursor_SetInputSizes()
-//   Set the sizes of the bind variables.
+// Cursor_GetFetchIntoBuffers()
+//   Acquire writable buffers from the objects in the given sequence, one for
+// each fetch variable. The format of each buffer is returned as well and the
+// number of rows that fit in the smallest buffer is returned. Buffers for
+// null indicators must consist of single byte items.
 //-----------------------------------------------------------------------------
-static PyObject *Cursor_SetInputSizes(
+static int Cursor_GetFetchIntoBuffers(
     udt_Cursor *self,                   // cursor to fetch from
-    PyObject *args,                     // arguments
-    PyObject *keywordArgs)              // keyword arguments
+    PyObject *sequence,                 // sequence of buffer objects
+    Py_buffer *views,                   // buffer views to populate (OUT)
+    char *formats,                      // formats to populate (OUT or NULL)
+    int *numViews,                      // number of views acquired (OUT)
+    Py_ssize_t *maxRows)                // maximum rows (IN/OUT)
 {
-    int numPositionalArgs;
-    PyObject *key, *value;
+    PyObject *items;
+    Py_ssize_t numRows;
     udt_Variable *var;
-    Py_ssize_t i;
+    int i, numColumns;
+    char *format;
 
-    // only expect keyword arguments or positional arguments, not both
-    numPositionalArgs = PyTuple_Size(args);
-    if (keywordArgs && numPositionalArgs > 0) {
+    numColumns = PyList_GET_SIZE(self->fetchVariables);
+    items = PySequence_Fast(sequence, "expecting a sequence of buffers");
+    if (!items)
+        return -1;
+    if (PySequence_Fast_GET_SIZE(items) != numColumns) {
+        Py_DECREF(items);
         PyErr_SetString(g_InterfaceErrorException,
-                "expecting arguments or keyword arguments, not both");
-        return NULL;
+                "expecting one buffer for each column");
+        return -1;
     }
 
-    // make sure the cursor is open
-    if (Cursor_IsOpen(self) < 0)
-        return NULL;
+    for (i = 0; i < numColumns; i++) {
+        if (PyObject_GetBuffer(PySequence_Fast_GET_ITEM(items, i), &views[i],
+                PyBUF_CONTIG | PyBUF_FORMAT) < 0) {
+            Py_DECREF(items);
+            return -1;
+        }
+        *numViews = i + 1;
+
+        // native byte order prefixes are accepted; all others are not
+        format = views[i].format ? views[i].format : "B";
+        if (*format == '@' || *format == '=')
+            format++;
+        if (formats) {
+            var = (udt_Variable*) PyList_GET_ITEM(self->fetchVariables, i);
+            if (format[0] && format[1]) {
+                PyErr_Format(PyExc_TypeError,
+                        "unsupported buffer format '%s'", views[i].format);
+                Py_DECREF(items);
+                return -1;
+            }
+            if (NumberVar_VerifyBufferFormat(var, format[0]) < 0) {
+                Py_DECREF(items);
+                return -1;
+            }
+            formats[i] = format[0];
+        } else if (views[i].itemsize != 1) {
+            PyErr_SetString(PyExc_TypeError,
+                    "null buffers must consist of single byte items");
+            Py_DECREF(items);
+            return -1;
+        }
 
-    // eliminate existing bind variables
-    Py_XDECREF(self->bindVariables);
-    if (keywordArgs)
-        self->bindVariables = PyDict_New();
-    else self->bindVariables = PyList_New(numPositionalArgs);
+        numRows = views[i].len / views[i].itemsize;
+        if (numRows < *maxRows)
+            *maxRows = numRows;
+    }
+
+    Py_DECREF(items);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_FetchInto()
+//   Fetch rows directly into the writable buffers provided, one for each
+// column, and optionally record which values are null in a second set of
+// buffers. Only numeric columns are supported. The number of rows written to
+// the buffers is returned.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_FetchInto(
+    udt_Cursor *self,                   // cursor to fetch from
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "buffers", "nulls", NULL };
+    int numColumns, numViews, numNullViews, numBatchRows, i, j, result;
+    Py_ssize_t maxRows, numRows, row;
+    PyObject *buffers, *nulls;
+    Py_buffer *views;
+    udt_Variable *var;
+    char *formats, *target;
+
+    // parse arguments
+    nulls = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|O", keywordList,
+            &buffers, &nulls))
+        return NULL;
+    if (nulls == Py_None)
+        nulls = NULL;
+
+    // verify fetch can be performed
+    if (Cursor_VerifyFetch(self) < 0)
+        return NULL;
+    if (!self->fetchVariables) {
+        PyErr_SetString(g_InterfaceErrorException, "query not executed");
+        return NULL;
+    }
+
+    // allocate memory for the buffer views; the views for the null buffers
+    // follow those for the values
+    numColumns = PyList_GET_SIZE(self->fetchVariables);
+    views = PyMem_Malloc(numColumns * 2 * sizeof(Py_buffer));
+    formats = PyMem_Malloc(numColumns);
+    if (!views || !formats) {
+        PyMem_Free(views);
+        PyMem_Free(formats);
+        return PyErr_NoMemory();
+    }
+
+    // acquire the buffers
+    numViews = numNullViews = 0;
+    maxRows = PY_SSIZE_T_MAX;
+    result = Cursor_GetFetchIntoBuffers(self, buffers, views, formats,
+            &numViews, &maxRows);
+    if (result == 0 && nulls)
+        result = Cursor_GetFetchIntoBuffers(self, nulls, views + numColumns,
+                NULL, &numNullViews, &maxRows);
+
+    // copy as many rows as fit into the buffers
+    numRows = 0;
+    while (result == 0 && numRows < maxRows) {
+        result = Cursor_MoreRows(self);
+        if (result <= 0)
+            break;
+        result = 0;
+        numBatchRows = self->actualRows - self->rowNum;
+        if (numBatchRows > maxRows - numRows)
+            numBatchRows = (int) (maxRows - numRows);
+        for (i = 0; result == 0 && i < numColumns; i++) {
+            var = (udt_Variable*) PyList_GET_ITEM(self->fetchVariables, i);
+            for (j = 0; j < numBatchRows; j++) {
+                row = numRows + j;
+                target = (char*) views[i].buf + row * views[i].itemsize;
+                if (var->indicator[self->rowNum + j] == OCI_IND_NULL) {
+                    memset(target, 0, views[i].itemsize);
+                    if (nulls)
+                        ((char*) views[numColumns + i].buf)[row] = 1;
+                    continue;
+                }
+                if (nulls)
+                    ((char*) views[numColumns + i].buf)[row] = 0;
+                if (NumberVar_CopyToBuffer(var, self->rowNum + j, formats[i],
+                        views[i].itemsize, target) < 0) {
+                    result = -1;
+                    break;
+                }
+            }
+        }
+        self->rowNum += numBatchRows;
+        self->rowCount += numBatchRows;
+        numRows += numBatchRows;
+    }
+
+    // release the buffers
+    for (i = 0; i < numViews; i++)
+        PyBuffer_Release(&views[i]);
+    for (i = 0; i < numNullViews; i++)
+        PyBuffer_Release(&views[numColumns + i]);
+    PyMem_Free(views);
+    PyMem_Free(formats);
+    if (result < 0)
+        return NULL;
+
+    return PyInt_FromLong((long) numRows);
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Cursor_ParseAggregateSpec()
+//   Parse the specification passed to aggregate(), which is a sequence of
+// (function, column) tuples. The function is one of "count", "sum", "min" or
+// "max" and the column is the index of a column in the select list; for
+// "count" the column may also be None in order to count the rows.
+//-----------------------------------------------------------------------------
+static int Cursor_ParseAggregateSpec(
+    udt_Cursor *self,                   // cursor being aggregated
+    PyObject *spec,                     // specification to parse
+    udt_AggregateState *state)          // state to populate
+{
+    PyObject *items, *columnObj;
+    int i, numColumns, *function;
+    udt_Variable *var;
+    char *name;
+
+    items = PySequence_Fast(spec, "expecting a sequence of tuples");
+    if (!items)
+        return -1;
+    state->numItems = (int) PySequence_Fast_GET_SIZE(items);
+    if (state->numItems == 0) {
+        Py_DECREF(items);
+        PyErr_SetString(g_InterfaceErrorException,
+                "at least one aggregate must be specified");
+        return -1;
+    }
+    state->functions = PyMem_Malloc(state->numItems * 2 * sizeof(int));
+    if (!state->functions) {
+        Py_DECREF(items);
+        PyErr_NoMemory();
+        return -1;
+    }
+    state->columns = state->functions + state->numItems;
+
+    numColumns = PyList_GET_SIZE(self->fetchVariables);
+    for (i = 0; i < state->numItems; i++) {
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(items, i), "sO",
+                &name, &columnObj))
+            break;
+        function = &state->functions[i];
+        if (strcmp(name, "count") == 0)
+            *function = AGGREGATE_COUNT;
+        else if (strcmp(name, "sum") == 0)
+            *function = AGGREGATE_SUM;
+        else if (strcmp(name, "min") == 0)
+            *function = AGGREGATE_MIN;
+        else if (strcmp(name, "max") == 0)
+            *function = AGGREGATE_MAX;
+        else {
+            PyErr_SetString(g_InterfaceErrorException,
+                    "function must be one of count, sum, min or max");
+            break;
+        }
+        if (columnObj == Py_None && *function == AGGREGATE_COUNT) {
+            state->columns[i] = -1;
+            continue;
+        }
+        state->columns[i] = PyInt_AsLong(columnObj);
+        if (PyErr_Occurred())
+            break;
+        if (state->columns[i] < 0 || state->columns[i] >= numColumns) {
+            PyErr_SetString(PyExc_IndexError, "column index out of range");
+            break;
+        }
+        var = (udt_Variable*)
+                PyList_GET_ITEM(self->fetchVariables, state->columns[i]);
+        if (*function != AGGREGATE_COUNT && !NumberVar_IsNumeric(var)
+#ifdef SQLT_BFLOAT
+                && var->type != &vt_NativeFloat
+#endif
+                ) {
+            PyErr_SetString(g_NotSupportedErrorException,
+                    "sum, min and max require numeric columns");
+            break;
+        }
+    }
+
+    Py_DECREF(items);
+    return (i < state->numItems) ? -1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_GetAggregateGroup()
+//   Return the running values for the group to which the row at the given
+// array position belongs, adding a new group if necessary.
+//-----------------------------------------------------------------------------
+static udt_AggregateValue *Cursor_GetAggregateGroup(
+    udt_AggregateState *state,          // aggregate state
+    unsigned row)                       // array position of row
+{
+    udt_AggregateValue *temp;
+    PyObject *key, *groupIndex;
+    int group;
+
+    // without a group by column, all rows belong to the one group
+    if (!state->groupVar)
+        return state->values;
+
+    // look for an existing group
+    key = Variable_GetValue(state->groupVar, row);
+    if (!key)
+        return NULL;
+    groupIndex = PyDict_GetItem(state->groups, key);
+    if (groupIndex) {
+        Py_DECREF(key);
+        group = PyInt_AsLong(groupIndex);
+        return &state->values[group * state->numItems];
+    }
+
+    // add a new group, making room for it if necessary
+    if (state->numGroups == state->allocatedGroups) {
+        temp = PyMem_Realloc(state->values, state->allocatedGroups * 2 *
+                state->numItems * sizeof(udt_AggregateValue));
+        if (!temp) {
+            Py_DECREF(key);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        state->values = temp;
+        state->allocatedGroups *= 2;
+    }
+    group = state->numGroups;
+    groupIndex = PyInt_FromLong(group);
+    if (!groupIndex) {
+        Py_DECREF(key);
+        return NULL;
+    }
+    if (PyDict_SetItem(state->groups, key, groupIndex) < 0) {
+        Py_DECREF(groupIndex);
+        Py_DECREF(key);
+        return NULL;
+    }
+    Py_DECREF(groupIndex);
+    Py_DECREF(key);
+    state->numGroups++;
+    memset(&state->values[group * state->numItems], 0,
+            state->numItems * sizeof(udt_AggregateValue));
+    return &state->values[group * state->numItems];
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_AggregateRows()
+//   Fetch all remaining rows from the cursor and update the running values
+// directly from the fetch buffers.
+//-----------------------------------------------------------------------------
+static int Cursor_AggregateRows(
+    udt_Cursor *self,                   // cursor being aggregated
+    udt_AggregateState *state)          // aggregate state
+{
+    udt_AggregateValue *values;
+    int i, status, isNull;
+    udt_Variable *var;
+    unsigned row;
+
+    while (1) {
+        status = Cursor_MoreRows(self);
+        if (status <= 0)
+            return status;
+        for (row = self->rowNum; row < (unsigned) self->actualRows; row++) {
+            values = Cursor_GetAggregateGroup(state, row);
+            if (!values)
+                return -1;
+            for (i = 0; i < state->numItems; i++) {
+                if (state->columns[i] < 0) {
+                    values[i].count++;
+                    continue;
+                }
+                var = (udt_Variable*) PyList_GET_ITEM(self->fetchVariables,
+                        state->columns[i]);
+                if (var->type->isNullProc)
+                    isNull = (*var->type->isNullProc)(var, row);
+                else isNull = (var->indicator[row] == OCI_IND_NULL);
+                if (isNull)
+                    continue;
+                if (state->functions[i] == AGGREGATE_COUNT)
+                    values[i].count++;
+                else if (NumberVar_Aggregate(var, row, state->functions[i],
+                        &values[i]) < 0)
+                    return -1;
+            }
+        }
+        self->rowCount += self->actualRows - self->rowNum;
+        self->rowNum = self->actualRows;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_GetAggregateResult()
+//   Return a tuple containing the results of the aggregates for one group.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_GetAggregateResult(
+    udt_Cursor *self,                   // cursor being aggregated
+    udt_AggregateState *state,          // aggregate state
+    udt_AggregateValue *values)         // running values for the group
+{
+    PyObject *result, *value;
+    udt_Variable *var;
+    int i;
+
+    result = PyTuple_New(state->numItems);
+    if (!result)
+        return NULL;
+    for (i = 0; i < state->numItems; i++) {
+        if (state->functions[i] == AGGREGATE_COUNT)
+            value = PyLong_FromLongLong(values[i].count);
+        else {
+            var = (udt_Variable*) PyList_GET_ITEM(self->fetchVariables,
+                    state->columns[i]);
+            value = NumberVar_GetAggregateValue(var, &values[i]);
+        }
+        if (!value) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(result, i, value);
+    }
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_GetAggregateGroupResults()
+//   Return a dictionary mapping each value of the group by column to a tuple
+// containing the results of the aggregates for that group.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_GetAggregateGroupResults(
+    udt_Cursor *self,                   // cursor being aggregated
+    udt_AggregateState *state)          // aggregate state
+{
+    PyObject *results, *key, *groupIndex, *value;
+    Py_ssize_t pos;
+    int group;
+
+    results = PyDict_New();
+    if (!results)
+        return NULL;
+    pos = 0;
+    while (PyDict_Next(state->groups, &pos, &key, &groupIndex)) {
+        group = PyInt_AsLong(groupIndex);
+        value = Cursor_GetAggregateResult(self, state,
+                &state->values[group * state->numItems]);
+        if (!value) {
+            Py_DECREF(results);
+            return NULL;
+        }
+        if (PyDict_SetItem(results, key, value) < 0) {
+            Py_DECREF(value);
+            Py_DECREF(results);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+
+    return results;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_Aggregate()
+//   Fetch all remaining rows from the cursor and compute aggregates directly
+// from the fetch buffers without creating row objects. Without a column to
+// group by, a tuple with one result for each item in the specification is
+// returned; otherwise, a dictionary mapping each value of the group by column
+// to such a tuple is returned.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_Aggregate(
+    udt_Cursor *self,                   // cursor to aggregate
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "spec", "groupBy", NULL };
+    PyObject *spec, *groupByObj, *result;
+    udt_AggregateState state;
+    int groupBy;
+
+    // parse arguments
+    groupByObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|O", keywordList,
+            &spec, &groupByObj))
+        return NULL;
+
+    // verify fetch can be performed
+    if (Cursor_VerifyFetch(self) < 0)
+        return NULL;
+    if (!self->fetchVariables) {
+        PyErr_SetString(g_InterfaceErrorException, "query not executed");
+        return NULL;
+    }
+
+    // determine the column to group by, if any
+    memset(&state, 0, sizeof(state));
+    if (groupByObj && groupByObj != Py_None) {
+        groupBy = PyInt_AsLong(groupByObj);
+        if (PyErr_Occurred())
+            return NULL;
+        if (groupBy < 0 || groupBy >= PyList_GET_SIZE(self->fetchVariables)) {
+            PyErr_SetString(PyExc_IndexError, "column index out of range");
+            return NULL;
+        }
+        state.groupVar = (udt_Variable*)
+                PyList_GET_ITEM(self->fetchVariables, groupBy);
+    }
+
+    // parse the specification
+    if (Cursor_ParseAggregateSpec(self, spec, &state) < 0) {
+        PyMem_Free(state.functions);
+        return NULL;
+    }
+
+    // allocate the running values; a single group is used if no group by
+    // column was specified and groups are added as they are found otherwise
+    state.numGroups = (state.groupVar) ? 0 : 1;
+    state.allocatedGroups = 1;
+    state.values = PyMem_Malloc(state.numItems * sizeof(udt_AggregateValue));
+    state.groups = PyDict_New();
+    if (!state.values || !state.groups) {
+        PyMem_Free(state.functions);
+        PyMem_Free(state.values);
+        Py_XDECREF(state.groups);
+        return PyErr_NoMemory();
+    }
+    memset(state.values, 0, state.numItems * sizeof(udt_AggregateValue));
+
+    // process the rows and determine the results
+    if (Cursor_AggregateRows(self, &state) < 0)
+        result = NULL;
+    else if (!state.groupVar)
+        result = Cursor_GetAggregateResult(self, &state, state.values);
+    else result = Cursor_GetAggregateGroupResults(self, &state);
+
+    Py_DECREF(state.groups);
+    PyMem_Free(state.values);
+    PyMem_Free(state.functions);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_CopyFrom()
+//   Copy all remaining rows from the source cursor by executing the given
+// statement (usually an insert) in batches. The bind variables are created
+// with the same types as the fetch variables of the source cursor and bound by
+// position so that the data can be copied from buffer to buffer without
+// creating any Python objects. The number of rows copied is returned.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_CopyFrom(
+    udt_Cursor *self,                   // cursor to copy rows to
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "source", "statement", "batchSize", NULL };
+    int batchSize, numColumns, numRows, numBatchRows, status, i;
+    udt_Variable *sourceVar, *targetVar;
+    PyObject *statement, *bindVariables;
+    udt_Cursor *source;
+    long totalRows;
+
+    // parse arguments
+    batchSize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O!O|i", keywordList,
+            &g_CursorType, &source, &statement, &batchSize))
+        return NULL;
+    if (source == self) {
+        PyErr_SetString(g_InterfaceErrorException,
+                "source and target cursor must be different");
+        return NULL;
+    }
+
+    // make sure the cursors are open and the source has a query to fetch
+    if (Cursor_IsOpen(self) < 0)
+        return NULL;
+    if (Cursor_VerifyFetch(source) < 0)
+        return NULL;
+    if (!source->fetchVariables) {
+        PyErr_SetString(g_InterfaceErrorException, "query not executed");
+        return NULL;
+    }
+
+    // the data is copied as is so the encodings must match
+    if (strcmp(self->environment->encoding,
+                    source->environment->encoding) != 0 ||
+            strcmp(self->environment->nencoding,
+                    source->environment->nencoding) != 0) {
+        PyErr_SetString(g_NotSupportedErrorException,
+                "source and target connections must use the same encodings");
+        return NULL;
+    }
+    if (batchSize <= 0)
+        batchSize = source->fetchArraySize;
+
+    // prepare the statement
+    if (Cursor_InternalPrepare(self, statement, NULL) < 0)
+        return NULL;
+    if (self->statementType == OCI_STMT_SELECT) {
+        PyErr_SetString(g_NotSupportedErrorException,
+                "queries not supported: results undefined");
+        return NULL;
+    }
+
+    // create bind variables matching the fetch variables of the source
+    numColumns = PyList_GET_SIZE(source->fetchVariables);
+    bindVariables = PyList_New(numColumns);
+    if (!bindVariables)
+        return NULL;
+    for (i = 0; i < numColumns; i++) {
+        sourceVar = (udt_Variable*)
+                PyList_GET_ITEM(source->fetchVariables, i);
+        if (!sourceVar->type->canBeCopied) {
+            Py_DECREF(bindVariables);
+            PyErr_Format(g_NotSupportedErrorException,
+                    "column %d does not support copying", i + 1);
+            return NULL;
+        }
+        targetVar = Variable_New(self, batchSize, sourceVar->type,
+                sourceVar->size);
+        if (!targetVar) {
+            Py_DECREF(bindVariables);
+            return NULL;
+        }
+        PyList_SET_ITEM(bindVariables, i, (PyObject*) targetVar);
+    }
+    Py_XDECREF(self->bindVariables);
+    self->bindVariables = bindVariables;
+    if (Cursor_PerformBind(self) < 0)
+        return NULL;
+
+    // fill the bind variables from the source and execute for each batch
+    totalRows = 0;
+    do {
+        numRows = 0;
+        while (numRows < batchSize) {
+            status = Cursor_MoreRows(source);
+            if (status < 0)
+                return NULL;
+            if (status == 0)
+                break;
+            numBatchRows = source->actualRows - source->rowNum;
+            if (numBatchRows > batchSize - numRows)
+                numBatchRows = batchSize - numRows;
+            for (i = 0; i < numColumns; i++) {
+                sourceVar = (udt_Variable*)
+                        PyList_GET_ITEM(source->fetchVariables, i);
+                targetVar = (udt_Variable*)
+                        PyList_GET_ITEM(self->bindVariables, i);
+                if (Variable_CopyElements(targetVar, numRows, sourceVar,
+                        source->rowNum, numBatchRows) < 0)
+                    return NULL;
+            }
+            source->rowNum += numBatchRows;
+            source->rowCount += numBatchRows;
+            numRows += numBatchRows;
+        }
+        if (numRows > 0) {
+            if (Cursor_InternalExecute(self, numRows, OCI_DEFAULT) < 0)
+                return NULL;
+            totalRows += numRows;
+        }
+    } while (numRows == batchSize);
+
+    self->rowCount = totalRows;
+    return PyInt_FromLong(totalRows);
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_Scroll()
+//   Scroll the cursor to the requested position, which is the index of the
+// last row returned; the next row returned is the one following it. Positions
+// that are already in the fetch buffer are reached without a round trip; all
+// others are fetched with OCIStmtFetch2(). If the position is outside of the
+// result set, the state of the cursor is left unchanged.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_Scroll(
+    udt_Cursor *self,                   // cursor to scroll
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "value", "mode", NULL };
+    int value, target, bufferStart, numRows;
+    int savedRowCount;
+    ub4 currentPosition;
+    ub2 orientation;
+    sword status;
+    sb4 offset;
+    char *mode;
+
+    // parse arguments
+    value = 0;
+    mode = "relative";
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|is", keywordList,
+            &value, &mode))
+        return NULL;
+
+    // verify fetch can be performed
+    if (Cursor_VerifyFetch(self) < 0)
+        return NULL;
+    if (!self->isScrollable) {
+        PyErr_SetString(g_InterfaceErrorException, "cursor is not scrollable");
+        return NULL;
+    }
+    if (!self->fetchVariables) {
+        PyErr_SetString(g_InterfaceErrorException, "query not executed");
+        return NULL;
+    }
+
+    // determine the target position; relative positions are converted to
+    // absolute ones rather than being passed on to Oracle, whose position is
+    // the last row in the fetch buffer instead of the last row returned
+    numRows = self->fetchArraySize;
+    if (strcmp(mode, "relative") == 0) {
+        orientation = OCI_FETCH_ABSOLUTE;
+        target = self->rowCount + value;
+    } else if (strcmp(mode, "absolute") == 0) {
+        orientation = OCI_FETCH_ABSOLUTE;
+        target = value;
+    } else if (strcmp(mode, "first") == 0) {
+        orientation = OCI_FETCH_ABSOLUTE;
+        target = 1;
+    } else if (strcmp(mode, "last") == 0) {
+        orientation = OCI_FETCH_LAST;
+        target = 0;
+        numRows = 1;
+    } else {
+        PyErr_SetString(g_InterfaceErrorException,
+                "mode must be one of relative, absolute, first or last");
+        return NULL;
+    }
+    if (target < 0) {
+        PyErr_SetString(PyExc_IndexError, "scroll position out of range");
+        return NULL;
+    }
+
+    // if the target row or the row following it is in the fetch buffer,
+    // simply move to it
+    if (orientation != OCI_FETCH_LAST && self->actualRows > 0) {
+        bufferStart = self->rowCount - self->rowNum + 1;
+        if (target >= bufferStart - 1 &&
+                target < bufferStart + self->actualRows) {
+            self->rowNum = target - bufferStart + 1;
+            self->rowCount = target;
+            Py_INCREF(Py_None);
+            return Py_None;
+        }
+    }
+
+    // otherwise, fetch the rows starting at the target row, which is then
+    // treated as returned already; the fetch replaces the contents of the
+    // buffer so if it fails the buffer is invalidated and the rows following
+    // the current position are fetched again by the next fetch
+    savedRowCount = self->rowCount;
+    offset = (target > 0) ? target : 1;
+    if (Cursor_InternalFetch(self, numRows, orientation, offset) < 0) {
+        self->rowCount = savedRowCount;
+        self->rowNum = 0;
+        self->actualRows = -1;
+        return NULL;
+    }
+    if (self->actualRows == 0) {
+        if (orientation == OCI_FETCH_LAST || target == 0) {
+            self->rowCount = 0;
+            Py_INCREF(Py_None);
+            return Py_None;
+        }
+        self->rowCount = savedRowCount;
+        self->actualRows = -1;
+        PyErr_SetString(PyExc_IndexError, "scroll position out of range");
+        return NULL;
+    }
+
+    // Oracle is positioned on the last row in the buffer; the first row in
+    // the buffer is the target row unless scrolling to before the first row
+    status = OCIAttrGet(self->handle, OCI_HTYPE_STMT, &currentPosition, 0,
+            OCI_ATTR_CURRENT_POSITION, self->environment->errorHandle);
+    if (Environment_CheckForError(self->environment, status,
+            "Cursor_Scroll(): current position") < 0)
+        return NULL;
+    self->rowNum = (target == 0 && orientation != OCI_FETCH_LAST) ? 0 : 1;
+    self->rowCount = currentPosition - self->actualRows + self->rowNum;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cursor_SetInputSizes()
+//   Set the sizes of the bind variables.
+//-----------------------------------------------------------------------------
+static PyObject *Cursor_SetInputSizes(
+    udt_Cursor *self,                   // cursor to fetch from
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    int numPositionalArgs;
+    PyObject *key, *value;
+    udt_Variable *var;
+    Py_ssize_t i;
+
+    // only expect keyword arguments or positional arguments, not both
+    numPositionalArgs = PyTuple_Size(args);
+    if (keywordArgs && numPositionalArgs > 0) {
+        PyErr_SetString(g_InterfaceErrorException,
+                "expecting arguments or keyword arguments, not both");
+        return NULL;
+    }
+
+    // make sure the cursor is open
+    if (Cursor_IsOpen(self) < 0)
+        return NULL;
+
+    // eliminate existing bind variables
+    Py_XDECREF(self->bindVariables);
+    if (keywordArgs)
+        self->bindVariables = PyDict_New();
+    else self->bindVariables = PyList_New(numPositionalArgs);
     if (!self->bindVariables)
         return NULL;
     self->setInputSizes = 1;
@@ -2136,11 +3261,16 @@ static PyObject *Cursor_Var(
     Py_XINCREF(outConverter);
     var->outConverter = outConverter;
 
-    // define the object type if needed
+    // define the object type if needed; describing the type requires the
+    // connection to be established
     if (type == (PyObject*) &g_ObjectVarType) {
+        if (Connection_IsConnected(self->connection) < 0) {
+            Py_DECREF(var);
+            return NULL;
+        }
         objectVar = (udt_ObjectVar*) var;
         objectVar->objectType = ObjectType_NewByName(self->connection,
-                typeNameObj);
+                self->environment, typeNameObj);
         if (!objectVar->objectType) {
             Py_DECREF(var);
             return NULL;
@@ -2235,15 +3365,24 @@ static PyObject *Cursor_BindNames(
 
 //-----------------------------------------------------------------------------
 // Cursor_GetIter()
-//   Return a reference to the cursor which supports the iterator protocol.
+//   Return an iterator over the rows of the cursor. The cursor is validated
+// once here instead of for each row returned by the iterator.
 //-----------------------------------------------------------------------------
 static PyObject *Cursor_GetIter(
     udt_Cursor *self)                   // cursor
 {
+    udt_CursorIterator *iterator;
+
     if (Cursor_VerifyFetch(self) < 0)
         return NULL;
+    iterator = (udt_CursorIterator*)
+            g_CursorIteratorType.tp_alloc(&g_CursorIteratorType, 0);
+    if (!iterator)
+        return NULL;
     Py_INCREF(self);
-    return (PyObject*) self;
+    iterator->cursor = self;
+    iterator->generation = self->generation;
+    return (PyObject*) iterator;
 }
 
 
@@ -2268,3 +3407,44 @@ static PyObject *Cursor_GetNext(
     return NULL;
 }
 
+
+//-----------------------------------------------------------------------------
+// CursorIterator_Free()
+//   Free the memory associated with a cursor iterator.
+//-----------------------------------------------------------------------------
+static void CursorIterator_Free(
+    udt_CursorIterator *self)           // iterator to free
+{
+    Py_CLEAR(self->cursor);
+    Py_TYPE(self)->tp_free((PyObject*) self);
+}
+
+
+//-----------------------------------------------------------------------------
+// CursorIterator_GetNext()
+//   Return the next row from the cursor. Rows already in the fetch buffer are
+// returned directly unless the cursor has been prepared, executed or closed
+// since the last row; the cursor is validated again before each fetch.
+//-----------------------------------------------------------------------------
+static PyObject *CursorIterator_GetNext(
+    udt_CursorIterator *self)           // iterator
+{
+    udt_Cursor *cursor = self->cursor;
+    int status;
+
+    if (self->generation == cursor->generation &&
+            cursor->rowNum < cursor->actualRows)
+        return Cursor_CreateRow(cursor);
+
+    if (Cursor_VerifyFetch(cursor) < 0)
+        return NULL;
+    self->generation = cursor->generation;
+    status = Cursor_MoreRows(cursor);
+    if (status < 0)
+        return NULL;
+    else if (status > 0)
+        return Cursor_CreateRow(cursor);
+
+    // no more rows, return NULL without setting an exception
+    return NULL;
+}
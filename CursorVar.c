@@ -92,7 +92,8 @@ static int CursorVar_Initialize(
     if (!var->cursors)
         return -1;
     for (i = 0; i < var->allocatedElements; i++) {
-        tempCursor = (udt_Cursor*) Connection_NewCursor(var->connection, NULL);
+        tempCursor = (udt_Cursor*) Connection_NewCursor(var->connection, NULL,
+                NULL);
         if (!tempCursor) {
             Py_DECREF(var);
             return -1;
@@ -150,6 +151,7 @@ static int CursorVar_SetValue(
     }
     var->data[pos] = cursor->handle;
     cursor->statementType = -1;
+    cursor->generation++;
     return 0;
 }
 
@@ -166,6 +168,7 @@ static PyObject *CursorVar_GetValue(
 
     cursor = PyList_GET_ITEM(var->cursors, pos);
     ((udt_Cursor*) cursor)->statementType = -1;
+    ((udt_Cursor*) cursor)->generation++;
     Py_INCREF(cursor);
     return cursor;
 }
@@ -5,16 +5,27 @@
 
 //-----------------------------------------------------------------------------
 // DateTime type
+//   Dates are stored in the 7 byte internal format used by Oracle (SQLT_DAT)
+// so that they can be decoded directly without calling any OCI functions; the
+// last value decoded is retained since the same date is frequently repeated
+// in consecutive rows
 //-----------------------------------------------------------------------------
+#define DATETIME_SIZE                   7
+
 typedef struct {
     Variable_HEAD
-    OCIDate *data;
+    ub1 *data;
+    PyObject *lastValue;
+    ub1 lastData[DATETIME_SIZE];
+    ub4 unitsPerSecond;
 } udt_DateTimeVar;
 
 
 //-----------------------------------------------------------------------------
 // Declaration of date/time variable functions.
 //-----------------------------------------------------------------------------
+static int DateTimeVar_InitializeAsEpoch(udt_DateTimeVar*, udt_Cursor*);
+static void DateTimeVar_Finalize(udt_DateTimeVar*);
 static int DateTimeVar_SetValue(udt_DateTimeVar*, unsigned, PyObject*);
 static PyObject *DateTimeVar_GetValue(udt_DateTimeVar*, unsigned);
 
@@ -52,7 +63,7 @@ static PyTypeObject g_DateTimeVarType = {
 //-----------------------------------------------------------------------------
 static udt_VariableType vt_DateTime = {
     (InitializeProc) NULL,
-    (FinalizeProc) NULL,
+    (FinalizeProc) DateTimeVar_Finalize,
     (PreDefineProc) NULL,
     (PostDefineProc) NULL,
     (PreFetchProc) NULL,
@@ -61,9 +72,9 @@ static udt_VariableType vt_DateTime = {
     (GetValueProc) DateTimeVar_GetValue,
     (GetBufferSizeProc) NULL,
     &g_DateTimeVarType,                 // Python type
-    SQLT_ODT,                           // Oracle type
+    SQLT_DAT,                           // Oracle type
     SQLCS_IMPLICIT,                     // charset form
-    sizeof(OCIDate),                    // element length (default)
+    DATETIME_SIZE,                      // element length (default)
     0,                                  // is character data
     0,                                  // is variable length
     1,                                  // can be copied
@@ -73,7 +84,28 @@ static udt_VariableType vt_DateTime = {
 
 static udt_VariableType vt_Date = {
     (InitializeProc) NULL,
-    (FinalizeProc) NULL,
+    (FinalizeProc) DateTimeVar_Finalize,
+    (PreDefineProc) NULL,
+    (PostDefineProc) NULL,
+    (PreFetchProc) NULL,
+    (IsNullProc) NULL,
+    (SetValueProc) DateTimeVar_SetValue,
+    (GetValueProc) DateTimeVar_GetValue,
+    (GetBufferSizeProc) NULL,
+    &g_DateTimeVarType,                 // Python type
+    SQLT_DAT,                           // Oracle type
+    SQLCS_IMPLICIT,                     // charset form
+    DATETIME_SIZE,                      // element length (default)
+    0,                                  // is character data
+    0,                                  // is variable length
+    1,                                  // can be copied
+    1                                   // can be in array
+};
+
+
+static udt_VariableType vt_DateTimeAsEpoch = {
+    (InitializeProc) DateTimeVar_InitializeAsEpoch,
+    (FinalizeProc) DateTimeVar_Finalize,
     (PreDefineProc) NULL,
     (PostDefineProc) NULL,
     (PreFetchProc) NULL,
@@ -82,9 +114,9 @@ static udt_VariableType vt_Date = {
     (GetValueProc) DateTimeVar_GetValue,
     (GetBufferSizeProc) NULL,
     &g_DateTimeVarType,                 // Python type
-    SQLT_ODT,                           // Oracle type
+    SQLT_DAT,                           // Oracle type
     SQLCS_IMPLICIT,                     // charset form
-    sizeof(OCIDate),                    // element length (default)
+    DATETIME_SIZE,                      // element length (default)
     0,                                  // is character data
     0,                                  // is variable length
     1,                                  // can be copied
@@ -92,6 +124,20 @@ static udt_VariableType vt_Date = {
 };
 
 
+//-----------------------------------------------------------------------------
+// DateTimeVar_InitializeAsEpoch()
+//   Initialize the variable so that values are returned as integers relative
+// to the epoch in the units requested by the cursor.
+//-----------------------------------------------------------------------------
+static int DateTimeVar_InitializeAsEpoch(
+    udt_DateTimeVar *var,               // variable to initialize
+    udt_Cursor *cursor)                 // cursor variable associated with
+{
+    var->unitsPerSecond = cursor->timestampsAsEpoch;
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // DateTimeVar_SetValue()
 //   Set the value of the variable.
@@ -101,7 +147,7 @@ static int DateTimeVar_SetValue(
     unsigned pos,                       // array position to set
     PyObject *value)                    // value to set
 {
-    ub1 month, day, hour, minute, second;
+    ub1 month, day, hour, minute, second, *data;
     short year;
 
     if (PyDateTime_Check(value)) {
@@ -122,13 +168,30 @@ static int DateTimeVar_SetValue(
     }
 
     // store a copy of the value
-    OCIDateSetDate(&var->data[pos], year, month, day);
-    OCIDateSetTime(&var->data[pos], hour, minute, second);
+    data = &var->data[pos * DATETIME_SIZE];
+    data[0] = (ub1) (year / 100 + 100);
+    data[1] = (ub1) (year % 100 + 100);
+    data[2] = month;
+    data[3] = day;
+    data[4] = hour + 1;
+    data[5] = minute + 1;
+    data[6] = second + 1;
 
     return 0;
 }
 
 
+//-----------------------------------------------------------------------------
+// DateTimeVar_Finalize()
+//   Prepare for variable destruction.
+//-----------------------------------------------------------------------------
+static void DateTimeVar_Finalize(
+    udt_DateTimeVar *var)               // variable to free
+{
+    Py_CLEAR(var->lastValue);
+}
+
+
 //-----------------------------------------------------------------------------
 // DateTimeVar_GetValue()
 //   Returns the value stored at the given array position.
@@ -137,6 +200,38 @@ static PyObject *DateTimeVar_GetValue(
     udt_DateTimeVar *var,               // variable to determine value for
     unsigned pos)                       // array position
 {
-    return OracleDateToPythonDate(var->type, &var->data[pos]);
+    PyObject *value;
+    int year;
+    ub1 *data;
+
+    // if the value is the same as the last one decoded, return it again
+    data = &var->data[pos * DATETIME_SIZE];
+    if (var->lastValue && memcmp(data, var->lastData, DATETIME_SIZE) == 0) {
+        Py_INCREF(var->lastValue);
+        return var->lastValue;
+    }
+
+    // decode the value directly from the internal format
+    year = (data[0] - 100) * 100 + data[1] - 100;
+    if (var->unitsPerSecond)
+        value = OracleDateToPythonEpoch(year, data[2], data[3], data[4] - 1,
+                data[5] - 1, data[6] - 1, 0, var->unitsPerSecond);
+    else if (var->type == &vt_Date)
+        value = PyDate_FromDate(year, data[2], data[3]);
+    else value = PyDateTime_FromDateAndTime(year, data[2], data[3],
+            data[4] - 1, data[5] - 1, data[6] - 1, 0);
+    if (!value)
+        return NULL;
+
+    // retain the value for comparison with the next one requested; variables
+    // created by callbacks are never finalized so they cannot retain values
+    if (var->isAllocatedInternally) {
+        Py_XDECREF(var->lastValue);
+        Py_INCREF(value);
+        var->lastValue = value;
+        memcpy(var->lastData, data, DATETIME_SIZE);
+    }
+
+    return value;
 }
 
@@ -10,10 +10,12 @@ typedef struct {
     PyObject_HEAD
     OCIEnv *handle;
     OCIError *errorHandle;
+    int threaded;
     int maxBytesPerCharacter;
     int fixedWidth;
     char *encoding;
     char *nencoding;
+    int encodingType;
     ub4 maxStringBytes;
     PyObject *cloneEnv;
     udt_Buffer numberToStringFormatBuffer;
@@ -27,6 +29,19 @@ typedef struct {
 #define MAX_STRING_CHARS                4000
 #define MAX_BINARY_BYTES                4000
 
+//-----------------------------------------------------------------------------
+// types of encodings which are decoded directly rather than by name
+//-----------------------------------------------------------------------------
+#define ENCODING_TYPE_OTHER             0
+#define ENCODING_TYPE_ASCII             1
+#define ENCODING_TYPE_LATIN1            2
+#define ENCODING_TYPE_UTF8              3
+
+//-----------------------------------------------------------------------------
+// environments shared by standalone connections, keyed by their settings
+//-----------------------------------------------------------------------------
+static PyObject *g_SharedEnvironments = NULL;
+
 //-----------------------------------------------------------------------------
 // forward declarations
 //-----------------------------------------------------------------------------
@@ -80,6 +95,7 @@ static udt_Environment *Environment_New(
         return NULL;
     env->handle = NULL;
     env->errorHandle = NULL;
+    env->threaded = 0;
     env->fixedWidth = 1;
     env->maxBytesPerCharacter = 1;
     env->maxStringBytes = MAX_STRING_CHARS;
@@ -173,6 +189,106 @@ static int Environment_SetBuffer(
 }
 
 
+//-----------------------------------------------------------------------------
+// Environment_GetEncodingType()
+//   Return the type of encoding given its name so that strings in the most
+// common encodings can be decoded without looking up the codec each time.
+//-----------------------------------------------------------------------------
+static int Environment_GetEncodingType(
+    const char *encoding)               // name of encoding
+{
+    char normalizedName[16];
+    unsigned i = 0;
+
+    // ignore case and punctuation so that UTF-8 and utf8 are the same
+    for (; *encoding && i < sizeof(normalizedName) - 1; encoding++) {
+        if (*encoding >= 'A' && *encoding <= 'Z')
+            normalizedName[i++] = *encoding - 'A' + 'a';
+        else if (*encoding != '-' && *encoding != '_')
+            normalizedName[i++] = *encoding;
+    }
+    if (*encoding)
+        return ENCODING_TYPE_OTHER;
+    normalizedName[i] = '\0';
+
+    if (strcmp(normalizedName, "utf8") == 0)
+        return ENCODING_TYPE_UTF8;
+    if (strcmp(normalizedName, "iso88591") == 0 ||
+            strcmp(normalizedName, "latin1") == 0)
+        return ENCODING_TYPE_LATIN1;
+    if (strcmp(normalizedName, "usascii") == 0 ||
+            strcmp(normalizedName, "ascii") == 0)
+        return ENCODING_TYPE_ASCII;
+    return ENCODING_TYPE_OTHER;
+}
+
+
+#if PY_VERSION_HEX >= 0x03030000
+//-----------------------------------------------------------------------------
+// Environment_IsAscii()
+//   Return whether or not the data contains only ASCII characters. The data
+// is examined a word at a time for as long as possible.
+//-----------------------------------------------------------------------------
+static int Environment_IsAscii(
+    const char *data,                   // data to examine
+    Py_ssize_t numBytes)                // number of bytes to examine
+{
+    const size_t highBits = ((size_t) -1 / 0xFF) * 0x80;
+    const char *end = data + numBytes;
+    size_t word;
+
+    while (end - data >= (Py_ssize_t) sizeof(size_t)) {
+        memcpy(&word, data, sizeof(size_t));
+        if (word & highBits)
+            return 0;
+        data += sizeof(size_t);
+    }
+    for (; data < end; data++) {
+        if (*data & 0x80)
+            return 0;
+    }
+    return 1;
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Environment_DecodeString()
+//   Return a Python string given data in the encoding of the environment.
+// Data that is entirely ASCII is copied directly into a new string when the
+// encoding is compatible with ASCII.
+//-----------------------------------------------------------------------------
+static PyObject *Environment_DecodeString(
+    udt_Environment *environment,       // environment
+    const char *data,                   // data to decode
+    Py_ssize_t numBytes)                // number of bytes to decode
+{
+#if PY_MAJOR_VERSION >= 3
+#if PY_VERSION_HEX >= 0x03030000
+    PyObject *result;
+
+    if (environment->encodingType != ENCODING_TYPE_OTHER &&
+            Environment_IsAscii(data, numBytes)) {
+        result = PyUnicode_New(numBytes, 127);
+        if (!result)
+            return NULL;
+        memcpy(PyUnicode_1BYTE_DATA(result), data, numBytes);
+        return result;
+    }
+#endif
+    switch (environment->encodingType) {
+        case ENCODING_TYPE_UTF8:
+            return PyUnicode_DecodeUTF8(data, numBytes, NULL);
+        case ENCODING_TYPE_LATIN1:
+            return PyUnicode_DecodeLatin1(data, numBytes, NULL);
+        case ENCODING_TYPE_ASCII:
+            return PyUnicode_DecodeASCII(data, numBytes, NULL);
+    }
+#endif
+    return cxString_FromEncodedString(data, numBytes, environment->encoding);
+}
+
+
 //-----------------------------------------------------------------------------
 // Environment_NewFromScratch()
 //   Create a new environment object from scratch.
@@ -213,6 +329,7 @@ static udt_Environment *Environment_NewFromScratch(
         OCIHandleFree(handle, OCI_HTYPE_ENV);
         return NULL;
     }
+    env->threaded = threaded;
 
     // acquire max bytes per character
     status = OCINlsNumericInfoGet(env->handle, env->errorHandle,
@@ -240,6 +357,7 @@ static udt_Environment *Environment_NewFromScratch(
     if (Environment_GetCharacterSetName(env, OCI_ATTR_ENV_NCHARSET_ID,
             nencoding, &env->nencoding) < 0)
         return NULL;
+    env->encodingType = Environment_GetEncodingType(env->encoding);
 
     // fill buffers for number formats
     if (Environment_SetBuffer(&env->numberToStringFormatBuffer, "TM9",
@@ -270,6 +388,7 @@ static udt_Environment *Environment_Clone(
     env = Environment_New(cloneEnv->handle);
     if (!env)
         return NULL;
+    env->threaded = cloneEnv->threaded;
     env->maxBytesPerCharacter = cloneEnv->maxBytesPerCharacter;
     env->maxStringBytes = cloneEnv->maxStringBytes;
     env->fixedWidth = cloneEnv->fixedWidth;
@@ -277,6 +396,7 @@ static udt_Environment *Environment_Clone(
     env->cloneEnv = (PyObject*) cloneEnv;
     env->encoding = cloneEnv->encoding;
     env->nencoding = cloneEnv->nencoding;
+    env->encodingType = cloneEnv->encodingType;
     cxBuffer_Copy(&env->numberToStringFormatBuffer,
             &cloneEnv->numberToStringFormatBuffer);
     cxBuffer_Copy(&env->numberFromStringFormatBuffer,
@@ -287,6 +407,54 @@ static udt_Environment *Environment_Clone(
 }
 
 
+//-----------------------------------------------------------------------------
+// Environment_NewShared()
+//   Return a clone of the environment shared by standalone connections that
+// use the same settings. The shared environment is created the first time it
+// is needed and is kept for the life of the process; each clone has its own
+// error handle. Only environments in threaded mode are shared since only then
+// does the OCI protect the environment handle against concurrent use.
+//-----------------------------------------------------------------------------
+static udt_Environment *Environment_NewShared(
+    int events,                         // use events mode?
+    char *encoding,                     // override value for encoding
+    char *nencoding)                    // override value for nencoding
+{
+    udt_Environment *sharedEnv;
+    PyObject *key;
+
+    // create the dictionary of shared environments, if needed
+    if (!g_SharedEnvironments) {
+        g_SharedEnvironments = PyDict_New();
+        if (!g_SharedEnvironments)
+            return NULL;
+    }
+
+    // look up the shared environment, creating it if needed
+    key = Py_BuildValue("(izz)", events, encoding, nencoding);
+    if (!key)
+        return NULL;
+    sharedEnv = (udt_Environment*) PyDict_GetItem(g_SharedEnvironments, key);
+    if (!sharedEnv) {
+        sharedEnv = Environment_NewFromScratch(1, events, encoding, nencoding);
+        if (!sharedEnv) {
+            Py_DECREF(key);
+            return NULL;
+        }
+        if (PyDict_SetItem(g_SharedEnvironments, key,
+                (PyObject*) sharedEnv) < 0) {
+            Py_DECREF(sharedEnv);
+            Py_DECREF(key);
+            return NULL;
+        }
+        Py_DECREF(sharedEnv);
+    }
+    Py_DECREF(key);
+
+    return Environment_Clone(sharedEnv);
+}
+
+
 //-----------------------------------------------------------------------------
 // Environment_Free()
 //   Deallocate the environment. Note that destroying the environment handle
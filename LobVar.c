@@ -392,6 +392,11 @@ static int LobVar_SetValue(
     ub1 lobType;
     ub4 amount;
 
+    // make sure we are actually connected since the value may be set before
+    // the variable is first bound
+    if (Connection_IsConnected(var->connection) < 0)
+        return -1;
+
     // make sure have temporary LOBs set up
     status = OCILobIsTemporary(var->environment->handle,
             var->environment->errorHandle, var->data[position], &isTemporary);
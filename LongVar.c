@@ -9,6 +9,7 @@
 typedef struct {
     Variable_HEAD
     char *data;
+    udt_DynamicBuffer *buffers;
 } udt_LongVar;
 
 
@@ -18,6 +19,12 @@ typedef struct {
 static int LongVar_SetValue(udt_LongVar*, unsigned, PyObject*);
 static PyObject *LongVar_GetValue(udt_LongVar*, unsigned);
 static ub4 LongVar_GetBufferSize(udt_LongVar*);
+static int LongVar_InitializeDynamic(udt_LongVar*, udt_Cursor*);
+static void LongVar_FinalizeDynamic(udt_LongVar*);
+static int LongVar_PreFetchDynamic(udt_LongVar*);
+static int LongVar_SetDynamicValue(udt_LongVar*, unsigned, PyObject*);
+static PyObject *LongVar_GetDynamicValue(udt_LongVar*, unsigned);
+static ub4 LongVar_GetDynamicBufferSize(udt_LongVar*);
 
 
 //-----------------------------------------------------------------------------
@@ -118,6 +125,48 @@ static udt_VariableType vt_LongBinary = {
 };
 
 
+static udt_VariableType vt_DynamicLongString = {
+    (InitializeProc) LongVar_InitializeDynamic,
+    (FinalizeProc) LongVar_FinalizeDynamic,
+    (PreDefineProc) NULL,
+    (PostDefineProc) NULL,
+    (PreFetchProc) LongVar_PreFetchDynamic,
+    (IsNullProc) NULL,
+    (SetValueProc) LongVar_SetDynamicValue,
+    (GetValueProc) LongVar_GetDynamicValue,
+    (GetBufferSizeProc) LongVar_GetDynamicBufferSize,
+    &g_LongStringVarType,               // Python type
+    SQLT_CHR,                           // Oracle type
+    SQLCS_IMPLICIT,                     // charset form
+    0,                                  // element length (default)
+    1,                                  // is character data
+    1,                                  // is variable length
+    0,                                  // can be copied
+    0                                   // can be in array
+};
+
+
+static udt_VariableType vt_DynamicLongBinary = {
+    (InitializeProc) LongVar_InitializeDynamic,
+    (FinalizeProc) LongVar_FinalizeDynamic,
+    (PreDefineProc) NULL,
+    (PostDefineProc) NULL,
+    (PreFetchProc) LongVar_PreFetchDynamic,
+    (IsNullProc) NULL,
+    (SetValueProc) LongVar_SetDynamicValue,
+    (GetValueProc) LongVar_GetDynamicValue,
+    (GetBufferSizeProc) LongVar_GetDynamicBufferSize,
+    &g_LongBinaryVarType,               // Python type
+    SQLT_BIN,                           // Oracle type
+    SQLCS_IMPLICIT,                     // charset form
+    0,                                  // element length (default)
+    0,                                  // is character data
+    1,                                  // is variable length
+    0,                                  // can be copied
+    0                                   // can be in array
+};
+
+
 //-----------------------------------------------------------------------------
 // LongVar_SetValue()
 //   Set the value of the variable.
@@ -169,7 +218,7 @@ static PyObject *LongVar_GetValue(
     ptr += sizeof(ub4);
     if (var->type == &vt_LongBinary)
         return PyBytes_FromStringAndSize(ptr, size);
-    return cxString_FromEncodedString(ptr, size, var->environment->encoding);
+    return Environment_DecodeString(var->environment, ptr, size);
 }
 
 
@@ -185,3 +234,156 @@ static ub4 LongVar_GetBufferSize(
     return sizeof(ub4) + self->size * self->environment->maxBytesPerCharacter;
 }
 
+
+//-----------------------------------------------------------------------------
+// LongVar_InitializeDynamic()
+//   Initialize the buffers used for fetching long data dynamically.
+//-----------------------------------------------------------------------------
+static int LongVar_InitializeDynamic(
+    udt_LongVar *var,                   // variable to initialize
+    udt_Cursor *cursor)                 // cursor variable associated with
+{
+    var->buffers = Variable_AllocateDynamicBuffers((udt_Variable*) var);
+    if (!var->buffers)
+        return -1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// LongVar_FinalizeDynamic()
+//   Free the buffers used for fetching long data dynamically.
+//-----------------------------------------------------------------------------
+static void LongVar_FinalizeDynamic(
+    udt_LongVar *var)                   // variable to free
+{
+    if (var->buffers) {
+        Variable_FreeDynamicBuffers((udt_Variable*) var, var->buffers);
+        var->buffers = NULL;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// LongVar_PreFetchDynamic()
+//   Reset the length of each of the buffers prior to fetching into them; the
+// memory already allocated is retained. Return codes are not supplied to
+// Oracle as intermediate pieces would be reported as truncated.
+//-----------------------------------------------------------------------------
+static int LongVar_PreFetchDynamic(
+    udt_LongVar *var)                   // variable to prepare
+{
+    ub4 i;
+
+    for (i = 0; i < var->allocatedElements; i++) {
+        var->buffers[i].length = 0;
+        var->buffers[i].pieceLength = 0;
+        var->buffers[i].numPieces = 0;
+        var->returnCode[i] = 0;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// LongVar_DefineCallback()
+//   Callback invoked by Oracle during a fetch to acquire the location into
+// which the next piece of long data for a row is to be placed. Note that this
+// is called while the GIL is released.
+//-----------------------------------------------------------------------------
+static sb4 LongVar_DefineCallback(
+    udt_LongVar *var,                   // variable being fetched into
+    OCIDefine *defineHandle,            // define handle
+    ub4 iteration,                      // row within the fetch
+    dvoid **bufferPtr,                  // location of piece (OUT)
+    ub4 **lengthPtr,                    // length of piece (OUT)
+    ub1 *piece,                         // piece being fetched
+    dvoid **indicatorPtr,               // indicator (OUT)
+    ub2 **returnCodePtr)                // return code (OUT)
+{
+    udt_DynamicBuffer *buffer;
+
+    // the previous piece, if any, is now complete; grow the buffer if it was
+    // filled completely
+    buffer = &var->buffers[iteration];
+    buffer->length += buffer->pieceLength;
+    if (Variable_GrowDynamicBuffer(buffer, 1) < 0)
+        return OCI_ERROR;
+
+    // supply the remainder of the buffer for the next piece
+    buffer->pieceLength = buffer->allocatedLength - buffer->length;
+    *bufferPtr = buffer->ptr + buffer->length;
+    *lengthPtr = &buffer->pieceLength;
+    *indicatorPtr = &var->indicator[iteration];
+    *returnCodePtr = NULL;
+
+    return OCI_CONTINUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// LongVar_SetDynamicValue()
+//   Set the value of the variable.
+//-----------------------------------------------------------------------------
+static int LongVar_SetDynamicValue(
+    udt_LongVar *var,                   // variable to set value for
+    unsigned pos,                       // array position to set
+    PyObject *value)                    // value to set
+{
+    udt_DynamicBuffer *buffer;
+    udt_Buffer data;
+
+    // get the buffer data and size
+    if (cxBuffer_FromObject(&data, value, var->environment->encoding) < 0)
+        return -1;
+
+    // copy the data into the buffer for the row
+    buffer = &var->buffers[pos];
+    buffer->length = 0;
+    buffer->pieceLength = 0;
+    if (Variable_GrowDynamicBuffer(buffer, (ub4) data.size) < 0) {
+        cxBuffer_Clear(&data);
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (data.size)
+        memcpy(buffer->ptr, data.ptr, data.size);
+    buffer->length = (ub4) data.size;
+    cxBuffer_Clear(&data);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// LongVar_GetDynamicValue()
+//   Returns the value stored at the given array position.
+//-----------------------------------------------------------------------------
+static PyObject *LongVar_GetDynamicValue(
+    udt_LongVar *var,                   // variable to determine value for
+    unsigned pos)                       // array position
+{
+    udt_DynamicBuffer *buffer;
+    const char *ptr;
+    ub4 size;
+
+    buffer = &var->buffers[pos];
+    size = buffer->length + buffer->pieceLength;
+    ptr = (buffer->ptr) ? buffer->ptr : "";
+    if (var->type == &vt_DynamicLongBinary)
+        return PyBytes_FromStringAndSize(ptr, size);
+    return Environment_DecodeString(var->environment, ptr, size);
+}
+
+
+//-----------------------------------------------------------------------------
+// LongVar_GetDynamicBufferSize()
+//   Returns the size of the buffer to use; no fixed buffer is needed when long
+// data is fetched dynamically.
+//-----------------------------------------------------------------------------
+static ub4 LongVar_GetDynamicBufferSize(
+    udt_LongVar *self)                  // variable to get buffer size
+{
+    return 0;
+}
@@ -20,16 +20,45 @@ typedef struct {
 #endif
 
 
+//-----------------------------------------------------------------------------
+// Aggregate functions computed by Cursor.aggregate() and the running value
+// kept for each of them
+//-----------------------------------------------------------------------------
+#define AGGREGATE_COUNT                 1
+#define AGGREGATE_SUM                   2
+#define AGGREGATE_MIN                   3
+#define AGGREGATE_MAX                   4
+
+typedef struct {
+    PY_LONG_LONG count;
+    OCINumber value;
+    double nativeValue;
+} udt_AggregateValue;
+
+
 //-----------------------------------------------------------------------------
 // Declaration of number variable functions.
 //-----------------------------------------------------------------------------
+static int NumberVar_GetPrecisionAndScale(udt_Environment*, OCIParam*, sb2*,
+        sb1*);
 static int NumberVar_PreDefine(udt_NumberVar*, OCIParam*);
 static int NumberVar_SetValue(udt_NumberVar*, unsigned, PyObject*);
 static PyObject *NumberVar_GetValue(udt_NumberVar*, unsigned);
+static PyObject *NumberVar_GetValueFromNumber(udt_NumberVar*, OCINumber*);
 #ifdef SQLT_BFLOAT
 static int NativeFloatVar_SetValue(udt_NativeFloatVar*, unsigned, PyObject*);
 static PyObject *NativeFloatVar_GetValue(udt_NativeFloatVar*, unsigned);
 #endif
+static int NumberVar_IsNumeric(udt_Variable*);
+static int NumberVar_Aggregate(udt_Variable*, unsigned, int,
+        udt_AggregateValue*);
+static PyObject *NumberVar_GetAggregateValue(udt_Variable*,
+        udt_AggregateValue*);
+#if PY_VERSION_HEX >= 0x02060000
+static int NumberVar_VerifyBufferFormat(udt_Variable*, char);
+static int NumberVar_CopyToBuffer(udt_Variable*, unsigned, char, Py_ssize_t,
+        void*);
+#endif
 
 
 //-----------------------------------------------------------------------------
@@ -220,6 +249,36 @@ static udt_VariableType vt_Boolean = {
 };
 
 
+//-----------------------------------------------------------------------------
+// NumberVar_GetPrecisionAndScale()
+//   Return the precision and scale of the number described by the parameter
+// handle.
+//-----------------------------------------------------------------------------
+static int NumberVar_GetPrecisionAndScale(
+    udt_Environment *environment,       // environment to use
+    OCIParam *param,                    // parameter handle
+    sb2 *precision,                     // precision (OUT)
+    sb1 *scale)                         // scale (OUT)
+{
+    sword status;
+
+    *scale = 0;
+    *precision = 0;
+    status = OCIAttrGet(param, OCI_HTYPE_DESCRIBE, (dvoid*) scale, 0,
+            OCI_ATTR_SCALE, environment->errorHandle);
+    if (Environment_CheckForError(environment, status,
+            "NumberVar_GetPrecisionAndScale(): scale") < 0)
+        return -1;
+    status = OCIAttrGet(param, OCI_HTYPE_DESCRIBE, (dvoid*) precision, 0,
+            OCI_ATTR_PRECISION, environment->errorHandle);
+    if (Environment_CheckForError(environment, status,
+            "NumberVar_GetPrecisionAndScale(): precision") < 0)
+        return -1;
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // NumberVar_PreDefine()
 //   Set the type of value (integer, float or string) that will be returned
@@ -230,23 +289,13 @@ static int NumberVar_PreDefine(
     OCIParam *param)                    // parameter handle
 {
     sb2 precision;
-    sword status;
     sb1 scale;
 
     // if the return type has not already been specified, check to see if the
     // number can fit inside an integer by looking at the precision and scale
     if (var->type == &vt_Float) {
-        scale = 0;
-        precision = 0;
-        status = OCIAttrGet(param, OCI_HTYPE_DESCRIBE, (dvoid*) &scale, 0,
-                OCI_ATTR_SCALE, var->environment->errorHandle);
-        if (Environment_CheckForError(var->environment, status,
-                "NumberVar_PreDefine(): scale") < 0)
-            return -1;
-        status = OCIAttrGet(param, OCI_HTYPE_DESCRIBE, (dvoid*) &precision, 0,
-                OCI_ATTR_PRECISION, var->environment->errorHandle);
-        if (Environment_CheckForError(var->environment, status,
-                "NumberVar_PreDefine(): precision") < 0)
+        if (NumberVar_GetPrecisionAndScale(var->environment, param,
+                &precision, &scale) < 0)
             return -1;
         if (scale == 0 || (scale == -127 && precision == 0)) {
             var->type = &vt_LongInteger;
@@ -520,6 +569,19 @@ static int NumberVar_SetValue(
 static PyObject *NumberVar_GetValue(
     udt_NumberVar *var,                 // variable to determine value for
     unsigned pos)                       // array position
+{
+    return NumberVar_GetValueFromNumber(var, &var->data[pos]);
+}
+
+
+//-----------------------------------------------------------------------------
+// NumberVar_GetValueFromNumber()
+//   Returns the Python object for the given Oracle number, using the type of
+// the variable to determine what kind of object to create.
+//-----------------------------------------------------------------------------
+static PyObject *NumberVar_GetValueFromNumber(
+    udt_NumberVar *var,                 // variable to determine value for
+    OCINumber *value)                   // value to convert
 {
     PyObject *result, *stringObj;
     char stringValue[200];
@@ -532,7 +594,7 @@ static PyObject *NumberVar_GetValue(
 #else
     if (var->type == &vt_Boolean) {
 #endif
-        status = OCINumberToInt(var->environment->errorHandle, &var->data[pos],
+        status = OCINumberToInt(var->environment->errorHandle, value,
                 sizeof(long), OCI_NUMBER_SIGNED, (dvoid*) &integerValue);
         if (Environment_CheckForError(var->environment, status,
                 "NumberVar_GetValue(): as integer") < 0)
@@ -546,8 +608,7 @@ static PyObject *NumberVar_GetValue(
 
     if (var->type == &vt_NumberAsString || var->type == &vt_LongInteger) {
         stringLength = sizeof(stringValue);
-        status = OCINumberToText(var->environment->errorHandle,
-                &var->data[pos],
+        status = OCINumberToText(var->environment->errorHandle, value,
                 (text*) var->environment->numberToStringFormatBuffer.ptr,
                 var->environment->numberToStringFormatBuffer.size, NULL, 0,
                 &stringLength, (unsigned char*) stringValue);
@@ -571,7 +632,7 @@ static PyObject *NumberVar_GetValue(
         PyErr_Clear();
     }
 
-    return OracleNumberToPythonFloat(var->environment, &var->data[pos]);
+    return OracleNumberToPythonFloat(var->environment, value);
 }
 
 
@@ -606,3 +667,189 @@ static int NativeFloatVar_SetValue(
 }
 #endif
 
+
+//-----------------------------------------------------------------------------
+// NumberVar_IsNumeric()
+//   Return a boolean indicating if the variable stores Oracle numbers.
+//-----------------------------------------------------------------------------
+static int NumberVar_IsNumeric(
+    udt_Variable *var)                  // variable to check
+{
+#if PY_MAJOR_VERSION < 3
+    if (var->type == &vt_Integer)
+        return 1;
+#endif
+    return (var->type == &vt_Float || var->type == &vt_LongInteger ||
+            var->type == &vt_NumberAsString || var->type == &vt_Boolean);
+}
+
+
+//-----------------------------------------------------------------------------
+// NumberVar_Aggregate()
+//   Add the value stored at the given array position to the running value of
+// a sum, minimum or maximum. Null values are expected to have been skipped
+// already.
+//-----------------------------------------------------------------------------
+static int NumberVar_Aggregate(
+    udt_Variable *var,                  // variable to aggregate value from
+    unsigned pos,                       // array position
+    int function,                       // aggregate function
+    udt_AggregateValue *aggregate)      // running value
+{
+    OCINumber *value, total;
+    double nativeValue;
+    sword status;
+    sword result;
+
+#ifdef SQLT_BFLOAT
+    if (var->type == &vt_NativeFloat) {
+        nativeValue = ((udt_NativeFloatVar*) var)->data[pos];
+        if (aggregate->count++ == 0)
+            aggregate->nativeValue = nativeValue;
+        else if (function == AGGREGATE_SUM)
+            aggregate->nativeValue += nativeValue;
+        else if ((function == AGGREGATE_MIN &&
+                        nativeValue < aggregate->nativeValue) ||
+                (function == AGGREGATE_MAX &&
+                        nativeValue > aggregate->nativeValue))
+            aggregate->nativeValue = nativeValue;
+        return 0;
+    }
+#endif
+
+    // the first value simply becomes the running value
+    value = &((udt_NumberVar*) var)->data[pos];
+    if (aggregate->count++ == 0) {
+        aggregate->value = *value;
+        return 0;
+    }
+
+    // sums are calculated with Oracle number arithmetic so no precision is
+    // lost; the minimum and maximum are determined by comparison
+    if (function == AGGREGATE_SUM) {
+        status = OCINumberAdd(var->environment->errorHandle,
+                &aggregate->value, value, &total);
+        if (Environment_CheckForError(var->environment, status,
+                "NumberVar_Aggregate(): add") < 0)
+            return -1;
+        aggregate->value = total;
+    } else {
+        status = OCINumberCmp(var->environment->errorHandle, value,
+                &aggregate->value, &result);
+        if (Environment_CheckForError(var->environment, status,
+                "NumberVar_Aggregate(): compare") < 0)
+            return -1;
+        if ((function == AGGREGATE_MIN && result < 0) ||
+                (function == AGGREGATE_MAX && result > 0))
+            aggregate->value = *value;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// NumberVar_GetAggregateValue()
+//   Return the Python object for the running value of a sum, minimum or
+// maximum, or None if no values were aggregated.
+//-----------------------------------------------------------------------------
+static PyObject *NumberVar_GetAggregateValue(
+    udt_Variable *var,                  // variable values came from
+    udt_AggregateValue *aggregate)      // running value
+{
+    if (aggregate->count == 0) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+#ifdef SQLT_BFLOAT
+    if (var->type == &vt_NativeFloat)
+        return PyFloat_FromDouble(aggregate->nativeValue);
+#endif
+    return NumberVar_GetValueFromNumber((udt_NumberVar*) var,
+            &aggregate->value);
+}
+
+
+#if PY_VERSION_HEX >= 0x02060000
+//-----------------------------------------------------------------------------
+// NumberVar_VerifyBufferFormat()
+//   Verify that values of the variable can be copied into a buffer with the
+// given format character (as used by the struct module).
+//-----------------------------------------------------------------------------
+static int NumberVar_VerifyBufferFormat(
+    udt_Variable *var,                  // variable to verify
+    char format)                        // buffer format character
+{
+#ifdef SQLT_BFLOAT
+    if (var->type == &vt_NativeFloat) {
+        if (format == 'd' || format == 'f')
+            return 0;
+        PyErr_SetString(PyExc_TypeError,
+                "native floats can only be copied to float buffers");
+        return -1;
+    }
+#endif
+    if (!NumberVar_IsNumeric(var)) {
+        PyErr_SetString(g_NotSupportedErrorException,
+                "only numeric columns can be copied to buffers");
+        return -1;
+    }
+    if (!format || !strchr("bBhHiIlLqQfd", format)) {
+        PyErr_Format(PyExc_TypeError, "unsupported buffer format '%c'",
+                format);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// NumberVar_CopyToBuffer()
+//   Copy the value stored at the given array position into a buffer item,
+// converting it to the type indicated by the format character which has
+// already been verified.
+//-----------------------------------------------------------------------------
+static int NumberVar_CopyToBuffer(
+    udt_Variable *var,                  // variable to copy value from
+    unsigned pos,                       // array position
+    char format,                        // buffer format character
+    Py_ssize_t itemSize,                // size of the buffer item
+    void *target)                       // buffer item to copy value to
+{
+    OCINumber *value;
+    double nativeValue;
+    uword signFlag;
+    sword status;
+
+#ifdef SQLT_BFLOAT
+    if (var->type == &vt_NativeFloat) {
+        nativeValue = ((udt_NativeFloatVar*) var)->data[pos];
+        if (format == 'f')
+            *((float*) target) = (float) nativeValue;
+        else *((double*) target) = nativeValue;
+        return 0;
+    }
+#endif
+
+    value = &((udt_NumberVar*) var)->data[pos];
+    if (format == 'f' || format == 'd') {
+        status = OCINumberToReal(var->environment->errorHandle, value,
+                (uword) itemSize, target);
+        if (Environment_CheckForError(var->environment, status,
+                "NumberVar_CopyToBuffer(): as real") < 0)
+            return -1;
+        return 0;
+    }
+
+    // upper case format characters denote unsigned integers
+    signFlag = (format >= 'A' && format <= 'Z') ? OCI_NUMBER_UNSIGNED :
+            OCI_NUMBER_SIGNED;
+    status = OCINumberToInt(var->environment->errorHandle, value,
+            (uword) itemSize, signFlag, target);
+    if (Environment_CheckForError(var->environment, status,
+            "NumberVar_CopyToBuffer(): as integer") < 0)
+        return -1;
+    return 0;
+}
+#endif
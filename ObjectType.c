@@ -31,10 +31,12 @@ typedef struct {
 //-----------------------------------------------------------------------------
 // Declaration of type variable functions.
 //-----------------------------------------------------------------------------
-static udt_ObjectType *ObjectType_New(udt_Connection*, OCIParam*, ub4);
+static udt_ObjectType *ObjectType_New(udt_Connection*, udt_Environment*,
+        OCIParam*, ub4);
 static void ObjectType_Free(udt_ObjectType*);
 static PyObject *ObjectType_Repr(udt_ObjectType*);
-static udt_ObjectAttribute *ObjectAttribute_New(udt_Connection*, OCIParam*);
+static udt_ObjectAttribute *ObjectAttribute_New(udt_Connection*,
+        udt_Environment*, OCIParam*);
 static void ObjectAttribute_Free(udt_ObjectAttribute*);
 static PyObject *ObjectAttribute_Repr(udt_ObjectAttribute*);
 
@@ -222,8 +224,8 @@ static int ObjectType_Describe(
         // if element type is an object type get its type
         if (self->elementTypeCode == OCI_TYPECODE_OBJECT) {
             self->elementType = (PyObject*)
-                    ObjectType_New(connection, collectionParam,
-                            OCI_ATTR_TYPE_NAME);
+                    ObjectType_New(connection, self->environment,
+                            collectionParam, OCI_ATTR_TYPE_NAME);
             if (!self->elementType)
                 return -1;
         }
@@ -262,7 +264,8 @@ static int ObjectType_Describe(
         if (Environment_CheckForError(self->environment, status,
                 "ObjectType_Describe(): get attribute param descriptor") < 0)
             return -1;
-        attribute = ObjectAttribute_New(connection, attributeParam);
+        attribute = ObjectAttribute_New(connection, self->environment,
+                attributeParam);
         if (!attribute)
             return -1;
         PyList_SET_ITEM(self->attributes, i, (PyObject*) attribute);
@@ -353,6 +356,7 @@ static int ObjectType_Initialize(
 //-----------------------------------------------------------------------------
 static udt_ObjectType *ObjectType_New(
     udt_Connection *connection,         // connection for type information
+    udt_Environment *environment,       // environment to use
     OCIParam *param,                    // parameter descriptor
     ub4 nameAttribute)                  // value for the name attribute
 {
@@ -361,8 +365,8 @@ static udt_ObjectType *ObjectType_New(
     self = (udt_ObjectType*) g_ObjectTypeType.tp_alloc(&g_ObjectTypeType, 0);
     if (!self)
         return NULL;
-    Py_INCREF(connection->environment);
-    self->environment = connection->environment;
+    Py_INCREF(environment);
+    self->environment = environment;
     self->tdo = NULL;
     self->schema = NULL;
     self->name = NULL;
@@ -385,6 +389,7 @@ static udt_ObjectType *ObjectType_New(
 //-----------------------------------------------------------------------------
 static udt_ObjectType *ObjectType_NewByName(
     udt_Connection *connection,         // connection for type information
+    udt_Environment *environment,       // environment to use
     PyObject *name)                     // name of object type to describe
 {
     OCIDescribe *describeHandle;
@@ -394,23 +399,23 @@ static udt_ObjectType *ObjectType_NewByName(
     sword status;
 
     // allocate describe handle
-    status = OCIHandleAlloc(connection->environment->handle,
+    status = OCIHandleAlloc(environment->handle,
             (dvoid**) &describeHandle, OCI_HTYPE_DESCRIBE, 0, 0);
-    if (Environment_CheckForError(connection->environment, status,
+    if (Environment_CheckForError(environment, status,
             "ObjectType_NewByName(): allocate describe handle") < 0)
         return NULL;
 
     // describe the object
     if (cxBuffer_FromObject(&buffer, name,
-            connection->environment->encoding) < 0) {
+            environment->encoding) < 0) {
         OCIHandleFree(describeHandle, OCI_HTYPE_DESCRIBE);
         return NULL;
     }
     status = OCIDescribeAny(connection->handle,
-            connection->environment->errorHandle, (dvoid*) buffer.ptr,
+            environment->errorHandle, (dvoid*) buffer.ptr,
             buffer.size, OCI_OTYPE_NAME, 0, OCI_PTYPE_TYPE, describeHandle);
     cxBuffer_Clear(&buffer);
-    if (Environment_CheckForError(connection->environment, status,
+    if (Environment_CheckForError(environment, status,
             "ObjectType_NewByName(): describe type") < 0) {
         OCIHandleFree(describeHandle, OCI_HTYPE_DESCRIBE);
         return NULL;
@@ -418,15 +423,16 @@ static udt_ObjectType *ObjectType_NewByName(
 
     // get the parameter handle
     status = OCIAttrGet(describeHandle, OCI_HTYPE_DESCRIBE, &param, 0,
-            OCI_ATTR_PARAM, connection->environment->errorHandle);
-    if (Environment_CheckForError(connection->environment, status,
+            OCI_ATTR_PARAM, environment->errorHandle);
+    if (Environment_CheckForError(environment, status,
             "ObjectType_NewByName(): get parameter handle") < 0) {
         OCIHandleFree(describeHandle, OCI_HTYPE_DESCRIBE);
         return NULL;
     }
 
     // get object type
-    result = ObjectType_New(connection, param, OCI_ATTR_NAME);
+    result = ObjectType_New(connection, environment, param,
+            OCI_ATTR_NAME);
     if (!result) {
         OCIHandleFree(describeHandle, OCI_HTYPE_DESCRIBE);
         return NULL;
@@ -434,7 +440,7 @@ static udt_ObjectType *ObjectType_NewByName(
 
     // free the describe handle
     status = OCIHandleFree(describeHandle, OCI_HTYPE_DESCRIBE);
-    if (Environment_CheckForError(connection->environment, status,
+    if (Environment_CheckForError(environment, status,
             "ObjectType_NewByName(): free describe handle") < 0)
         return NULL;
 
@@ -500,6 +506,7 @@ static PyObject *ObjectType_Repr(
 static int ObjectAttribute_Initialize(
     udt_ObjectAttribute *self,          // object attribute to initialize
     udt_Connection *connection,         // connection in use
+    udt_Environment *environment,       // environment to use
     OCIParam *param)                    // parameter descriptor
 {
     sword status;
@@ -508,19 +515,19 @@ static int ObjectAttribute_Initialize(
 
     // determine the name of the attribute
     status = OCIAttrGet(param, OCI_DTYPE_PARAM, (dvoid*) &name, &size,
-            OCI_ATTR_NAME, connection->environment->errorHandle);
-    if (Environment_CheckForError(connection->environment, status,
+            OCI_ATTR_NAME, environment->errorHandle);
+    if (Environment_CheckForError(environment, status,
             "ObjectAttribute_Initialize(): get name") < 0)
         return -1;
     self->name = cxString_FromEncodedString(name, size,
-            connection->environment->encoding);
+            environment->encoding);
     if (!self->name)
         return -1;
 
     // determine the type of the attribute
     status = OCIAttrGet(param, OCI_DTYPE_PARAM, (dvoid*) &self->typeCode, 0,
-            OCI_ATTR_TYPECODE, connection->environment->errorHandle);
-    if (Environment_CheckForError(connection->environment, status,
+            OCI_ATTR_TYPECODE, environment->errorHandle);
+    if (Environment_CheckForError(environment, status,
             "ObjectAttribute_Initialize(): get type code") < 0)
         return -1;
 
@@ -528,7 +535,7 @@ static int ObjectAttribute_Initialize(
     switch (self->typeCode) {
         case OCI_TYPECODE_NAMEDCOLLECTION:
         case OCI_TYPECODE_OBJECT:
-            self->subType = ObjectType_New(connection, param,
+            self->subType = ObjectType_New(connection, environment, param,
                     OCI_ATTR_TYPE_NAME);
             if (!self->subType)
                 return -1;
@@ -545,6 +552,7 @@ static int ObjectAttribute_Initialize(
 //-----------------------------------------------------------------------------
 static udt_ObjectAttribute *ObjectAttribute_New(
     udt_Connection *connection,         // connection information
+    udt_Environment *environment,       // environment to use
     OCIParam *param)                    // parameter descriptor
 {
     udt_ObjectAttribute *self;
@@ -555,7 +563,8 @@ static udt_ObjectAttribute *ObjectAttribute_New(
         return NULL;
     self->name = NULL;
     self->subType = NULL;
-    if (ObjectAttribute_Initialize(self, connection, param) < 0) {
+    if (ObjectAttribute_Initialize(self, connection, environment,
+            param) < 0) {
         Py_DECREF(self);
         return NULL;
     }
@@ -0,0 +1,606 @@
+//-----------------------------------------------------------------------------
+// PoolGroup.c
+//   Handles groups of session pools among which sessions are acquired
+// according to a load balancing policy.
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// policies used for choosing the pool from which a session is acquired
+//-----------------------------------------------------------------------------
+#define POOLGROUP_LEASTBUSY             0
+#define POOLGROUP_ROUNDROBIN            1
+#define POOLGROUP_WEIGHTED              2
+
+//-----------------------------------------------------------------------------
+// structure for the state kept for each pool in the group
+//-----------------------------------------------------------------------------
+typedef struct {
+    udt_SessionPool *pool;
+    long weight;
+    long currentWeight;
+    PY_LONG_LONG unavailableUntil;
+} udt_PoolGroupMember;
+
+//-----------------------------------------------------------------------------
+// structure for the Python type "PoolGroup"
+//-----------------------------------------------------------------------------
+typedef struct {
+    PyObject_HEAD
+    PyObject *pools;
+    udt_PoolGroupMember *members;
+    Py_ssize_t numMembers;
+    Py_ssize_t nextMember;
+    int policy;
+    double retryDelay;
+} udt_PoolGroup;
+
+//-----------------------------------------------------------------------------
+// functions for the Python type "PoolGroup"
+//-----------------------------------------------------------------------------
+static PyObject *PoolGroup_New(PyTypeObject*, PyObject*, PyObject*);
+static int PoolGroup_Init(udt_PoolGroup*, PyObject*, PyObject*);
+static void PoolGroup_Free(udt_PoolGroup*);
+static PyObject *PoolGroup_Acquire(udt_PoolGroup*, PyObject*, PyObject*);
+static PyObject *PoolGroup_Drop(udt_PoolGroup*, PyObject*);
+static PyObject *PoolGroup_Release(udt_PoolGroup*, PyObject*, PyObject*);
+static PyObject *PoolGroup_GetAvailable(udt_PoolGroup*, void*);
+
+
+//-----------------------------------------------------------------------------
+// declaration of methods for Python type "PoolGroup"
+//-----------------------------------------------------------------------------
+static PyMethodDef g_PoolGroupMethods[] = {
+    { "acquire", (PyCFunction) PoolGroup_Acquire,
+            METH_VARARGS | METH_KEYWORDS },
+    { "drop", (PyCFunction) PoolGroup_Drop, METH_VARARGS },
+    { "release", (PyCFunction) PoolGroup_Release,
+            METH_VARARGS | METH_KEYWORDS },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of members for Python type "PoolGroup"
+//-----------------------------------------------------------------------------
+static PyMemberDef g_PoolGroupMembers[] = {
+    { "pools", T_OBJECT, offsetof(udt_PoolGroup, pools), READONLY },
+    { "policy", T_INT, offsetof(udt_PoolGroup, policy), READONLY },
+    { "retrydelay", T_DOUBLE, offsetof(udt_PoolGroup, retryDelay), 0 },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of calculated members for Python type "PoolGroup"
+//-----------------------------------------------------------------------------
+static PyGetSetDef g_PoolGroupCalcMembers[] = {
+    { "available", (getter) PoolGroup_GetAvailable, 0, 0, 0 },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of Python type "PoolGroup"
+//-----------------------------------------------------------------------------
+static PyTypeObject g_PoolGroupType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "OraclePoolGroup",                  // tp_name
+    sizeof(udt_PoolGroup),              // tp_basicsize
+    0,                                  // tp_itemsize
+    (destructor) PoolGroup_Free,        // tp_dealloc
+    0,                                  // tp_print
+    0,                                  // tp_getattr
+    0,                                  // tp_setattr
+    0,                                  // tp_compare
+    0,                                  // tp_repr
+    0,                                  // tp_as_number
+    0,                                  // tp_as_sequence
+    0,                                  // tp_as_mapping
+    0,                                  // tp_hash
+    0,                                  // tp_call
+    0,                                  // tp_str
+    0,                                  // tp_getattro
+    0,                                  // tp_setattro
+    0,                                  // tp_as_buffer
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+                                        // tp_flags
+    0,                                  // tp_doc
+    0,                                  // tp_traverse
+    0,                                  // tp_clear
+    0,                                  // tp_richcompare
+    0,                                  // tp_weaklistoffset
+    0,                                  // tp_iter
+    0,                                  // tp_iternext
+    g_PoolGroupMethods,                 // tp_methods
+    g_PoolGroupMembers,                 // tp_members
+    g_PoolGroupCalcMembers,             // tp_getset
+    0,                                  // tp_base
+    0,                                  // tp_dict
+    0,                                  // tp_descr_get
+    0,                                  // tp_descr_set
+    0,                                  // tp_dictoffset
+    (initproc) PoolGroup_Init,          // tp_init
+    0,                                  // tp_alloc
+    (newfunc) PoolGroup_New,            // tp_new
+    0,                                  // tp_free
+    0,                                  // tp_is_gc
+    0                                   // tp_bases
+};
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_New()
+//   Create a new pool group object.
+//-----------------------------------------------------------------------------
+static PyObject *PoolGroup_New(
+    PyTypeObject *type,                 // type object
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    udt_PoolGroup *newObject;
+
+    // create the object
+    newObject = (udt_PoolGroup*) type->tp_alloc(type, 0);
+    if (!newObject)
+        return NULL;
+    newObject->pools = NULL;
+    newObject->members = NULL;
+    newObject->numMembers = 0;
+
+    return (PyObject*) newObject;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_Init()
+//   Initialize the pool group object.
+//-----------------------------------------------------------------------------
+static int PoolGroup_Init(
+    udt_PoolGroup *self,                // pool group object
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "pools", "policy", "weights",
+            "retrydelay", NULL };
+    PyObject *poolsObj, *weightsObj, *pools, *weights, *pool;
+    udt_PoolGroupMember *members;
+    Py_ssize_t numPools, i;
+    double retryDelay;
+    long weight;
+    int policy;
+
+    // the members must not change once initialized since acquiring from them
+    // releases the global interpreter lock
+    if (self->members) {
+        PyErr_SetString(g_ProgrammingErrorException,
+                "pool group is already initialized");
+        return -1;
+    }
+
+    // parse arguments
+    weightsObj = NULL;
+    policy = POOLGROUP_LEASTBUSY;
+    retryDelay = 30.0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|iOd", keywordList,
+            &poolsObj, &policy, &weightsObj, &retryDelay))
+        return -1;
+    if (policy != POOLGROUP_LEASTBUSY && policy != POOLGROUP_ROUNDROBIN &&
+            policy != POOLGROUP_WEIGHTED) {
+        PyErr_SetString(g_ProgrammingErrorException, "invalid policy");
+        return -1;
+    }
+    if (retryDelay < 0) {
+        PyErr_SetString(g_ProgrammingErrorException,
+                "retrydelay must not be negative");
+        return -1;
+    }
+
+    // verify the pools
+    pools = PySequence_Tuple(poolsObj);
+    if (!pools)
+        return -1;
+    numPools = PyTuple_GET_SIZE(pools);
+    if (numPools == 0) {
+        Py_DECREF(pools);
+        PyErr_SetString(g_ProgrammingErrorException,
+                "at least one pool must be specified");
+        return -1;
+    }
+    for (i = 0; i < numPools; i++) {
+        pool = PyTuple_GET_ITEM(pools, i);
+        if (!PyObject_TypeCheck(pool, &g_SessionPoolType)) {
+            Py_DECREF(pools);
+            PyErr_SetString(g_ProgrammingErrorException,
+                    "expecting a sequence of session pools");
+            return -1;
+        }
+    }
+
+    // verify the weights, if specified
+    weights = NULL;
+    if (weightsObj && weightsObj != Py_None) {
+        weights = PySequence_Tuple(weightsObj);
+        if (!weights) {
+            Py_DECREF(pools);
+            return -1;
+        }
+        if (PyTuple_GET_SIZE(weights) != numPools) {
+            Py_DECREF(pools);
+            Py_DECREF(weights);
+            PyErr_SetString(g_ProgrammingErrorException,
+                    "expecting one weight for each pool");
+            return -1;
+        }
+    } else if (policy == POOLGROUP_WEIGHTED) {
+        Py_DECREF(pools);
+        PyErr_SetString(g_ProgrammingErrorException,
+                "weights must be specified for the weighted policy");
+        return -1;
+    }
+
+    // initialize the state kept for each pool
+    members = PyMem_Malloc(numPools * sizeof(udt_PoolGroupMember));
+    if (!members) {
+        Py_DECREF(pools);
+        Py_XDECREF(weights);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < numPools; i++) {
+        weight = 1;
+        if (weights) {
+            weight = PyInt_AsLong(PyTuple_GET_ITEM(weights, i));
+            if (PyErr_Occurred() || weight <= 0) {
+                if (!PyErr_Occurred())
+                    PyErr_SetString(g_ProgrammingErrorException,
+                            "weights must be positive integers");
+                PyMem_Free(members);
+                Py_DECREF(pools);
+                Py_DECREF(weights);
+                return -1;
+            }
+        }
+        members[i].pool = (udt_SessionPool*) PyTuple_GET_ITEM(pools, i);
+        members[i].weight = weight;
+        members[i].currentWeight = 0;
+        members[i].unavailableUntil = 0;
+    }
+    Py_XDECREF(weights);
+
+    // populate the members of the object; the tuple keeps the pools alive
+    self->pools = pools;
+    self->members = members;
+    self->numMembers = numPools;
+    self->nextMember = 0;
+    self->policy = policy;
+    self->retryDelay = retryDelay;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_Free()
+//   Deallocate the pool group.
+//-----------------------------------------------------------------------------
+static void PoolGroup_Free(
+    udt_PoolGroup *self)                // pool group
+{
+    if (self->members)
+        PyMem_Free(self->members);
+    Py_XDECREF(self->pools);
+    Py_TYPE(self)->tp_free((PyObject*) self);
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_IsAvailable()
+//   Return 1 if the pool is in rotation at the given time and 0 if it has
+// been taken out of rotation after failing to provide a session.
+//-----------------------------------------------------------------------------
+static int PoolGroup_IsAvailable(
+    udt_PoolGroupMember *member,        // member to check
+    PY_LONG_LONG now)                   // current time (microseconds)
+{
+    return (member->unavailableUntil <= now);
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_GetLoad()
+//   Return the load of the pool as the fraction of its maximum number of
+// sessions that are busy. The busy count is an attribute of the pool handle
+// so no round trip to the server is required.
+//-----------------------------------------------------------------------------
+static double PoolGroup_GetLoad(
+    udt_SessionPool *pool)              // pool to check
+{
+    sword status;
+    ub4 busy;
+
+    if (!pool->handle || pool->maxSessions == 0)
+        return 1.0;
+    status = OCIAttrGet(pool->handle, OCI_HTYPE_SPOOL, &busy, 0,
+            OCI_ATTR_SPOOL_BUSY_COUNT, pool->environment->errorHandle);
+    if (status != OCI_SUCCESS)
+        return 1.0;
+    return (double) busy / (double) pool->maxSessions;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_SelectMember()
+//   Select the member from which the next attempt to acquire a session will
+// be made, skipping those which have already been tried. Only pools in
+// rotation are considered; if none remain, the untried pool which is due to
+// return to rotation first is chosen instead. Returns -1 if all pools have
+// been tried.
+//-----------------------------------------------------------------------------
+static Py_ssize_t PoolGroup_SelectMember(
+    udt_PoolGroup *self,                // pool group
+    char *tried,                        // flags for the members tried
+    PY_LONG_LONG now)                   // current time (microseconds)
+{
+    udt_PoolGroupMember *member;
+    Py_ssize_t i, pos, selected;
+    double load, minLoad;
+    long totalWeight;
+
+    selected = -1;
+    switch (self->policy) {
+
+        // choose the pool with the lowest fraction of busy sessions
+        case POOLGROUP_LEASTBUSY:
+            minLoad = 0;
+            for (i = 0; i < self->numMembers; i++) {
+                member = &self->members[i];
+                if (tried[i] || !PoolGroup_IsAvailable(member, now))
+                    continue;
+                load = PoolGroup_GetLoad(member->pool);
+                if (selected < 0 || load < minLoad) {
+                    selected = i;
+                    minLoad = load;
+                }
+            }
+            break;
+
+        // choose the next pool in turn
+        case POOLGROUP_ROUNDROBIN:
+            for (i = 0; i < self->numMembers; i++) {
+                pos = (self->nextMember + i) % self->numMembers;
+                if (!tried[pos] &&
+                        PoolGroup_IsAvailable(&self->members[pos], now)) {
+                    selected = pos;
+                    self->nextMember = (pos + 1) % self->numMembers;
+                    break;
+                }
+            }
+            break;
+
+        // choose pools in proportion to their weights, spreading the choices
+        // of each pool evenly rather than choosing it several times in a row
+        case POOLGROUP_WEIGHTED:
+            totalWeight = 0;
+            for (i = 0; i < self->numMembers; i++) {
+                member = &self->members[i];
+                if (tried[i] || !PoolGroup_IsAvailable(member, now))
+                    continue;
+                member->currentWeight += member->weight;
+                totalWeight += member->weight;
+                if (selected < 0 || member->currentWeight >
+                        self->members[selected].currentWeight)
+                    selected = i;
+            }
+            if (selected >= 0)
+                self->members[selected].currentWeight -= totalWeight;
+            break;
+    }
+
+    // if no pool in rotation remains, choose the one returning first
+    if (selected < 0) {
+        for (i = 0; i < self->numMembers; i++) {
+            member = &self->members[i];
+            if (!tried[i] && (selected < 0 || member->unavailableUntil <
+                    self->members[selected].unavailableUntil))
+                selected = i;
+        }
+    }
+
+    return selected;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_IsPoolFailure()
+//   Return 1 if the exception that is set indicates that the database behind
+// the pool could not be reached and the pool should be taken out of rotation,
+// or 0 if it may be tried in another pool without penalty since the pool was
+// merely busy. Any other exception (such as one caused by the arguments or
+// the credentials) would be raised by the other pools as well so it should be
+// raised immediately and -1 is returned in that case.
+//-----------------------------------------------------------------------------
+static int PoolGroup_IsPoolFailure(void)
+{
+    switch (SessionPool_GetErrorCode()) {
+
+        // pools which time out waiting for a session or have no sessions
+        // left are busy, not failed
+        case 24418:
+        case 24457:
+            return 0;
+
+        // the instance is unavailable or the connection to it was lost
+        case 1033:
+        case 1034:
+        case 3113:
+        case 3114:
+        case 3135:
+        case 12170:
+        case 12514:
+        case 12528:
+        case 12537:
+        case 12541:
+            return 1;
+    }
+
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_Acquire()
+//   Acquire a connection from one of the pools in the group, chosen according
+// to the policy of the group. The arguments are passed through to the
+// acquire() method of the pool. If the pool is busy or its database cannot be
+// reached, the next pool is tried; pools whose database cannot be reached are
+// taken out of rotation for the retry delay.
+//-----------------------------------------------------------------------------
+static PyObject *PoolGroup_Acquire(
+    udt_PoolGroup *self,                // pool group
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    udt_PoolGroupMember *member;
+    PyObject *connection;
+    PY_LONG_LONG now;
+    Py_ssize_t pos;
+    char *tried;
+    int failed;
+
+    // make sure the pool group has pools
+    if (self->numMembers == 0) {
+        PyErr_SetString(g_InterfaceErrorException, "no pools in group");
+        return NULL;
+    }
+
+    // initialize the flags for the members tried
+    tried = PyMem_Malloc(self->numMembers);
+    if (!tried)
+        return PyErr_NoMemory();
+    memset(tried, 0, self->numMembers);
+
+    // try each pool in turn until a session is acquired; the error raised by
+    // the last pool tried is raised if none of them provide a session
+    connection = NULL;
+    now = SessionPool_GetTime();
+    while (1) {
+        pos = PoolGroup_SelectMember(self, tried, now);
+        if (pos < 0)
+            break;
+        PyErr_Clear();
+        tried[pos] = 1;
+        member = &self->members[pos];
+        connection = SessionPool_Acquire(member->pool, args, keywordArgs);
+        if (connection) {
+            member->unavailableUntil = 0;
+            break;
+        }
+
+        // determine whether the pool should be taken out of rotation or if
+        // the error should be raised immediately
+        failed = PoolGroup_IsPoolFailure();
+        if (failed < 0)
+            break;
+        now = SessionPool_GetTime();
+        if (failed)
+            member->unavailableUntil = now +
+                    (PY_LONG_LONG) (self->retryDelay * 1000000.0);
+    }
+
+    PyMem_Free(tried);
+    return connection;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_GetPool()
+//   Return the pool in the group from which the connection was acquired. An
+// exception is raised if it was not acquired from a pool in the group.
+//-----------------------------------------------------------------------------
+static udt_SessionPool *PoolGroup_GetPool(
+    udt_PoolGroup *self,                // pool group
+    PyObject *args)                     // arguments
+{
+    udt_Connection *connection;
+    Py_ssize_t i;
+
+    if (PyTuple_GET_SIZE(args) < 1 || !PyObject_TypeCheck(
+            PyTuple_GET_ITEM(args, 0), &g_ConnectionType)) {
+        PyErr_SetString(PyExc_TypeError, "expecting a connection");
+        return NULL;
+    }
+    connection = (udt_Connection*) PyTuple_GET_ITEM(args, 0);
+    for (i = 0; i < self->numMembers; i++) {
+        if (connection->sessionPool == self->members[i].pool)
+            return connection->sessionPool;
+    }
+    PyErr_SetString(g_ProgrammingErrorException,
+            "connection not acquired with this pool group");
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_Drop()
+//   Release a connection back to the pool from which it was acquired,
+// dropping it so that a new connection will be created if needed.
+//-----------------------------------------------------------------------------
+static PyObject *PoolGroup_Drop(
+    udt_PoolGroup *self,                // pool group
+    PyObject *args)                     // arguments
+{
+    udt_SessionPool *pool;
+
+    pool = PoolGroup_GetPool(self, args);
+    if (!pool)
+        return NULL;
+    return SessionPool_Drop(pool, args);
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_Release()
+//   Release a connection back to the pool from which it was acquired.
+//-----------------------------------------------------------------------------
+static PyObject *PoolGroup_Release(
+    udt_PoolGroup *self,                // pool group
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    udt_SessionPool *pool;
+
+    pool = PoolGroup_GetPool(self, args);
+    if (!pool)
+        return NULL;
+    return SessionPool_Release(pool, args, keywordArgs);
+}
+
+
+//-----------------------------------------------------------------------------
+// PoolGroup_GetAvailable()
+//   Return a list of the pools which are currently in rotation.
+//-----------------------------------------------------------------------------
+static PyObject *PoolGroup_GetAvailable(
+    udt_PoolGroup *self,                // pool group
+    void *arg)                          // optional argument (ignored)
+{
+    PyObject *result;
+    PY_LONG_LONG now;
+    Py_ssize_t i;
+
+    result = PyList_New(0);
+    if (!result)
+        return NULL;
+    now = SessionPool_GetTime();
+    for (i = 0; i < self->numMembers; i++) {
+        if (!PoolGroup_IsAvailable(&self->members[i], now))
+            continue;
+        if (PyList_Append(result, (PyObject*) self->members[i].pool) < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+    }
+
+    return result;
+}
+
@@ -3,6 +3,34 @@
 //   Handles session pooling (only available in Oracle 9i and up).
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// upper bounds (in microseconds) of the buckets of the acquire wait time
+// histogram; waits longer than the last bound are counted in a final bucket
+//-----------------------------------------------------------------------------
+static const ub4 gc_AcquireWaitBuckets[] = { 1000, 2000, 5000, 10000, 20000,
+        50000, 100000, 200000, 500000, 1000000, 2000000, 5000000 };
+#define NUM_ACQUIRE_WAIT_BUCKETS \
+        (sizeof(gc_AcquireWaitBuckets) / sizeof(gc_AcquireWaitBuckets[0]))
+
+//-----------------------------------------------------------------------------
+// structure for the statistics gathered by the session pool
+//-----------------------------------------------------------------------------
+typedef struct {
+    unsigned long acquires;
+    unsigned long acquireErrors;
+    unsigned long timeouts;
+    unsigned long exhausted;
+    unsigned long releases;
+    unsigned long drops;
+    unsigned long sessionsCreated;
+    unsigned long sessionsReused;
+    ub4 peakBusy;
+    ub4 lastOpened;
+    PY_LONG_LONG totalWaitTime;
+    PY_LONG_LONG maxWaitTime;
+    unsigned long waitHistogram[NUM_ACQUIRE_WAIT_BUCKETS + 1];
+} udt_SessionPoolStats;
+
 //-----------------------------------------------------------------------------
 // structure for the Python type "SessionPool"
 //-----------------------------------------------------------------------------
@@ -20,6 +48,7 @@ typedef struct {
     PyObject *dsn;
     udt_Environment *environment;
     PyTypeObject *connectionType;
+    udt_SessionPoolStats stats;
 } udt_SessionPool;
 
 //-----------------------------------------------------------------------------
@@ -29,6 +58,13 @@ static ub4 gc_OpenAttribute = OCI_ATTR_SPOOL_OPEN_COUNT;
 static ub4 gc_BusyAttribute = OCI_ATTR_SPOOL_BUSY_COUNT;
 static ub4 gc_TimeoutAttribute = OCI_ATTR_SPOOL_TIMEOUT;
 static ub4 gc_GetModeAttribute = OCI_ATTR_SPOOL_GETMODE;
+#ifdef OCI_ATTR_SPOOL_WAIT_TIMEOUT
+static ub4 gc_WaitTimeoutAttribute = OCI_ATTR_SPOOL_WAIT_TIMEOUT;
+#endif
+#ifdef OCI_ATTR_SPOOL_MAX_LIFETIME_SESSION
+static ub4 gc_MaxLifetimeSessionAttribute =
+        OCI_ATTR_SPOOL_MAX_LIFETIME_SESSION;
+#endif
 
 //-----------------------------------------------------------------------------
 // functions for the Python type "SessionPool"
@@ -38,9 +74,15 @@ static int SessionPool_Init(udt_SessionPool*, PyObject*, PyObject*);
 static void SessionPool_Free(udt_SessionPool*);
 static PyObject *SessionPool_Acquire(udt_SessionPool*, PyObject*, PyObject*);
 static PyObject *SessionPool_Drop(udt_SessionPool*, PyObject*);
-static PyObject *SessionPool_Release(udt_SessionPool*, PyObject*);
+static PyObject *SessionPool_Release(udt_SessionPool*, PyObject*, PyObject*);
 static PyObject *SessionPool_GetOCIAttr(udt_SessionPool*, ub4*);
 static int SessionPool_SetOCIAttr(udt_SessionPool*, PyObject*, ub4*);
+static PyObject *SessionPool_GetStats(udt_SessionPool*, PyObject*, PyObject*);
+static PyObject *SessionPool_Warmup(udt_SessionPool*, PyObject*, PyObject*);
+static PY_LONG_LONG SessionPool_GetTime(void);
+static void SessionPool_Sleep(unsigned);
+static void SessionPool_AcquireCompleted(udt_SessionPool*, int,
+        PY_LONG_LONG);
 
 
 //-----------------------------------------------------------------------------
@@ -50,7 +92,12 @@ static PyMethodDef g_SessionPoolMethods[] = {
     { "acquire", (PyCFunction) SessionPool_Acquire,
             METH_VARARGS | METH_KEYWORDS },
     { "drop", (PyCFunction) SessionPool_Drop, METH_VARARGS },
-    { "release", (PyCFunction) SessionPool_Release, METH_VARARGS },
+    { "release", (PyCFunction) SessionPool_Release,
+            METH_VARARGS | METH_KEYWORDS },
+    { "stats", (PyCFunction) SessionPool_GetStats,
+            METH_VARARGS | METH_KEYWORDS },
+    { "warmup", (PyCFunction) SessionPool_Warmup,
+            METH_VARARGS | METH_KEYWORDS },
     { NULL }
 };
 
@@ -83,6 +130,15 @@ static PyGetSetDef g_SessionPoolCalcMembers[] = {
             (setter) SessionPool_SetOCIAttr, 0, &gc_TimeoutAttribute },
     { "getmode", (getter) SessionPool_GetOCIAttr,
             (setter) SessionPool_SetOCIAttr, 0, &gc_GetModeAttribute },
+#ifdef OCI_ATTR_SPOOL_WAIT_TIMEOUT
+    { "waittimeout", (getter) SessionPool_GetOCIAttr,
+            (setter) SessionPool_SetOCIAttr, 0, &gc_WaitTimeoutAttribute },
+#endif
+#ifdef OCI_ATTR_SPOOL_MAX_LIFETIME_SESSION
+    { "maxlifetimesession", (getter) SessionPool_GetOCIAttr,
+            (setter) SessionPool_SetOCIAttr, 0,
+            &gc_MaxLifetimeSessionAttribute },
+#endif
     { NULL }
 };
 
@@ -295,6 +351,15 @@ static int SessionPool_Init(
             "SessionPool_New(): set wait mode") < 0)
         return -1;
 
+    // note the sessions opened when the pool was created so that they are
+    // not counted as sessions created when acquiring
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL,
+            &self->stats.lastOpened, 0, OCI_ATTR_SPOOL_OPEN_COUNT,
+            self->environment->errorHandle);
+    if (Environment_CheckForError(self->environment, status,
+            "SessionPool_New(): get open count") < 0)
+        return -1;
+
     return 0;
 }
 
@@ -311,6 +376,8 @@ static void SessionPool_Free(
                 OCI_SPD_FORCE);
         OCIHandleFree(self->handle, OCI_HTYPE_SPOOL);
     }
+    if (self->environment)
+        Connection_ClearFreeList(self->environment);
     Py_XDECREF(self->name);
     Py_XDECREF(self->environment);
     Py_XDECREF(self->username);
@@ -336,6 +403,154 @@ static int SessionPool_IsConnected(
 }
 
 
+//-----------------------------------------------------------------------------
+// SessionPool_GetErrorCode()
+//   Return the Oracle error code of the database error that is set or 0 if
+// the exception that is set is not a database error.
+//-----------------------------------------------------------------------------
+static sb4 SessionPool_GetErrorCode(void)
+{
+    PyObject *type, *value, *traceback, *errorObj, *errorArgs;
+    sb4 result;
+
+    if (!PyErr_ExceptionMatches(g_DatabaseErrorException))
+        return 0;
+
+    // the error object may be the exception value itself or its first
+    // argument, depending on whether the exception has been normalized
+    result = 0;
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_NormalizeException(&type, &value, &traceback);
+    errorObj = NULL;
+    if (value && PyObject_TypeCheck(value, &g_ErrorType)) {
+        Py_INCREF(value);
+        errorObj = value;
+    } else if (value) {
+        errorArgs = PyObject_GetAttrString(value, "args");
+        if (!errorArgs)
+            PyErr_Clear();
+        else {
+            if (PyTuple_Check(errorArgs) && PyTuple_GET_SIZE(errorArgs) > 0) {
+                errorObj = PyTuple_GET_ITEM(errorArgs, 0);
+                Py_INCREF(errorObj);
+            }
+            Py_DECREF(errorArgs);
+        }
+    }
+    if (errorObj && PyObject_TypeCheck(errorObj, &g_ErrorType))
+        result = ((udt_Error*) errorObj)->code;
+    Py_XDECREF(errorObj);
+    PyErr_Restore(type, value, traceback);
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_IsBusyError()
+//   Return 1 if the exception that is set indicates that the pool had no free
+// session, either because it could not open further sessions (ORA-24418, when
+// the "get" mode is NOWAIT) or because it timed out waiting for one
+// (ORA-24457, when the "get" mode is TIMEDWAIT), and 0 otherwise.
+//-----------------------------------------------------------------------------
+static int SessionPool_IsBusyError(void)
+{
+    sb4 code;
+
+    code = SessionPool_GetErrorCode();
+    return (code == 24418 || code == 24457);
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_GetDeadline()
+//   Return the time by which a session must be acquired for the given timeout
+// (in seconds). The timeout is enforced by retrying the acquisition while the
+// pool is busy, which requires a "get" mode that does not block indefinitely
+// when no session is free.
+//-----------------------------------------------------------------------------
+static int SessionPool_GetDeadline(
+    udt_SessionPool *self,              // session pool
+    PyObject *timeoutObj,               // timeout (in seconds)
+    PY_LONG_LONG *deadline)             // time by which to acquire (out)
+{
+    double timeoutValue;
+    sword status;
+    ub1 getMode;
+
+    timeoutValue = PyFloat_AsDouble(timeoutObj);
+    if (PyErr_Occurred())
+        return -1;
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL, &getMode, 0,
+            OCI_ATTR_SPOOL_GETMODE, self->environment->errorHandle);
+    if (Environment_CheckForError(self->environment, status,
+            "SessionPool_Acquire(): get mode") < 0)
+        return -1;
+    if (getMode == OCI_SPOOL_ATTRVAL_WAIT) {
+        PyErr_SetString(g_ProgrammingErrorException,
+                "timeout cannot be enforced when the get mode of the pool "
+                "is SPOOL_ATTRVAL_WAIT");
+        return -1;
+    }
+    *deadline = SessionPool_GetTime();
+    if (timeoutValue > 0)
+        *deadline += (PY_LONG_LONG) (timeoutValue * 1000000);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_WaitToRetry()
+//   Called after an attempt to acquire a session has failed. If the pool was
+// busy and the deadline has not passed, the exception is cleared and the
+// thread sleeps (starting at a millisecond and backing off to a maximum of 20
+// milliseconds) before the next attempt. If the deadline has passed, the
+// exception is replaced with one indicating that the acquisition timed out.
+// Any other exception is left in place and -1 is returned.
+//-----------------------------------------------------------------------------
+static int SessionPool_WaitToRetry(
+    udt_SessionPool *self,              // session pool
+    PY_LONG_LONG deadline,              // time by which to acquire
+    unsigned *sleepTime)                // time to sleep (milliseconds)
+{
+    PY_LONG_LONG remaining;
+    udt_Error *error;
+
+    // only a busy pool is retried
+    if (!SessionPool_IsBusyError())
+        return -1;
+    PyErr_Clear();
+
+    // raise an exception if the deadline has passed
+    remaining = deadline - SessionPool_GetTime();
+    if (remaining <= 0) {
+        error = Error_New(self->environment, "SessionPool_Acquire()", 0);
+        if (!error)
+            return -1;
+        error->code = 24457;
+        error->message = cxString_FromAscii(
+                "timed out waiting for a free session in the pool");
+        if (!error->message) {
+            Py_DECREF(error);
+            return -1;
+        }
+        PyErr_SetObject(g_DatabaseErrorException, (PyObject*) error);
+        Py_DECREF(error);
+        return -1;
+    }
+
+    // sleep before the next attempt, without passing the deadline
+    if ((PY_LONG_LONG) *sleepTime * 1000 > remaining)
+        *sleepTime = (unsigned) (remaining / 1000) + 1;
+    Py_BEGIN_ALLOW_THREADS
+    SessionPool_Sleep(*sleepTime);
+    Py_END_ALLOW_THREADS
+    *sleepTime = (*sleepTime * 2 < 20) ? *sleepTime * 2 : 20;
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // SessionPool_Acquire()
 //   Create a new connection within the session pool.
@@ -346,17 +561,24 @@ static PyObject *SessionPool_Acquire(
     PyObject *keywordArgs)              // keyword arguments
 {
     static char *keywordList[] = { "user", "password", "cclass", "purity",
-            NULL };
-    PyObject *createKeywordArgs, *result, *cclassObj, *purityObj;
-    unsigned usernameLength, passwordLength;
+            "timeout", "tag", "matchanytag", "lazy", NULL };
+    PyObject *createKeywordArgs, *result, *cclassObj, *purityObj, *timeoutObj;
+    PyObject *tagObj, *matchAnyTagObj, *lazyObj;
+    unsigned usernameLength, passwordLength, sleepTime;
+    PY_LONG_LONG deadline, startTime;
+    int matchAnyTag, lazy, timed;
     char *username, *password;
+    ub4 purity;
 
     // parse arguments
     username = NULL;
     password = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|s#s#OO", keywordList,
-            &username, &usernameLength, &password, &passwordLength, &cclassObj,
-            &purityObj))
+    cclassObj = purityObj = timeoutObj = tagObj = matchAnyTagObj = NULL;
+    lazyObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|s#s#OOOOOO",
+            keywordList, &username, &usernameLength, &password,
+            &passwordLength, &cclassObj, &purityObj, &timeoutObj, &tagObj,
+            &matchAnyTagObj, &lazyObj))
         return NULL;
     if (self->homogeneous && (username || password)) {
         PyErr_SetString(g_ProgrammingErrorException,
@@ -368,22 +590,101 @@ static PyObject *SessionPool_Acquire(
     if (SessionPool_IsConnected(self) < 0)
         return NULL;
 
-    // create arguments
+    // determine if the session is acquired lazily
+    lazy = 0;
+    if (lazyObj) {
+        lazy = PyObject_IsTrue(lazyObj);
+        if (lazy < 0)
+            return NULL;
+    }
+
+    // determine the deadline for acquiring a session, if applicable; an
+    // acquisition with a timeout may take several attempts so the statistics
+    // of the pool are updated once for all of them rather than per attempt
+    if (timeoutObj == Py_None)
+        timeoutObj = NULL;
+    deadline = 0;
+    if (timeoutObj && SessionPool_GetDeadline(self, timeoutObj,
+            &deadline) < 0)
+        return NULL;
+    timed = (timeoutObj && !lazy);
+    startTime = SessionPool_GetTime();
+    sleepTime = 1;
+
+    // acquire directly for the default connection type if no credentials or
+    // positional arguments are specified
+    if (self->connectionType == &g_ConnectionType && !username &&
+            !password && PyTuple_GET_SIZE(args) == 0) {
+        purity = 0;
+#ifdef ORACLE_11G
+        purity = OCI_ATTR_PURITY_DEFAULT;
+#endif
+        if (purityObj) {
+            purity = (ub4) PyInt_AsLong(purityObj);
+            if (PyErr_Occurred())
+                return NULL;
+        }
+        matchAnyTag = 0;
+        if (matchAnyTagObj) {
+            matchAnyTag = PyObject_IsTrue(matchAnyTagObj);
+            if (matchAnyTag < 0)
+                return NULL;
+        }
+        while (1) {
+            result = (PyObject*) Connection_NewFromPool(self, cclassObj,
+                    purity, tagObj, matchAnyTag, lazy, timed);
+            if (result || !timeoutObj ||
+                    SessionPool_WaitToRetry(self, deadline, &sleepTime) < 0)
+                break;
+        }
+        if (timed)
+            SessionPool_AcquireCompleted(self, (result) ? 0 : -1,
+                    SessionPool_GetTime() - startTime);
+        return result;
+    }
+
+    // create arguments; the timeout is not an argument of the connection
     if (keywordArgs)
         createKeywordArgs = PyDict_Copy(keywordArgs);
     else createKeywordArgs = PyDict_New();
     if (!createKeywordArgs)
         return NULL;
+    if (PyDict_GetItemString(createKeywordArgs, "timeout") &&
+            PyDict_DelItemString(createKeywordArgs, "timeout") < 0) {
+        Py_DECREF(createKeywordArgs);
+        return NULL;
+    }
     if (PyDict_SetItemString(createKeywordArgs, "pool",
             (PyObject*) self) < 0) {
         Py_DECREF(createKeywordArgs);
         return NULL;
     }
 
-    // create the connection object
-    result = PyObject_Call( (PyObject*) self->connectionType, args,
-            createKeywordArgs);
+    // create the connection object; when acquiring with a timeout the object
+    // is created and initialized separately so that it can be marked as not
+    // updating the statistics of the pool itself
+    while (1) {
+        if (!timed)
+            result = PyObject_Call( (PyObject*) self->connectionType, args,
+                    createKeywordArgs);
+        else {
+            result = self->connectionType->tp_new(self->connectionType, args,
+                    createKeywordArgs);
+            if (result && PyObject_TypeCheck(result, self->connectionType)) {
+                ((udt_Connection*) result)->skipPoolStats = 1;
+                if (Py_TYPE(result)->tp_init(result, args,
+                        createKeywordArgs) < 0)
+                    Py_CLEAR(result);
+            }
+        }
+        if (result || !timeoutObj ||
+                SessionPool_WaitToRetry(self, deadline, &sleepTime) < 0)
+            break;
+    }
     Py_DECREF(createKeywordArgs);
+    if (timed)
+        SessionPool_AcquireCompleted(self, (result) ? 0 : -1,
+                SessionPool_GetTime() - startTime);
 
     return result;
 }
@@ -397,45 +698,75 @@ static PyObject *SessionPool_Acquire(
 static PyObject *SessionPool_InternalRelease(
     udt_SessionPool *self,              // session pool
     PyObject *args,                     // arguments
+    PyObject *keywordArgs,              // keyword arguments
     ub4 mode)                           // OCI mode to use
 {
+    static char *keywordList[] = { "connection", "tag", NULL };
     udt_Connection *connection;
+    udt_Buffer tagBuffer;
+    PyObject *tagObj;
     sword status;
 
     // connection is expected
-    if (!PyArg_ParseTuple(args, "O!", &g_ConnectionType, &connection))
+    tagObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O!|O", keywordList,
+            &g_ConnectionType, &connection, &tagObj))
         return NULL;
 
     // make sure session pool is connected
     if (SessionPool_IsConnected(self) < 0)
         return NULL;
+    Connection_WaitForConnect(connection);
     if (connection->sessionPool != self) {
         PyErr_SetString(g_ProgrammingErrorException,
                 "connection not acquired with this session pool");
         return NULL;
     }
 
-    // attempt a rollback but if dropping the connection from the pool
-    // ignore the error
-    Py_BEGIN_ALLOW_THREADS
-    status = OCITransRollback(connection->handle,
-            connection->environment->errorHandle, OCI_DEFAULT);
-    Py_END_ALLOW_THREADS
-    if (Environment_CheckForError(connection->environment, status,
-            "SessionPool_Release(): rollback") < 0) {
-        if (mode != OCI_SESSRLS_DROPSESS)
-            return NULL;
-        PyErr_Clear();
+    // a connection acquired lazily which was never used has no session
+    if (connection->connectPending) {
+        Connection_ClearDeferred(connection);
+        Py_CLEAR(connection->sessionPool);
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
+    // attempt a rollback if a transaction may be in progress but if dropping
+    // the connection from the pool ignore the error
+    if (Connection_TransactionInProgress(connection)) {
+        Py_BEGIN_ALLOW_THREADS
+        status = OCITransRollback(connection->handle,
+                connection->environment->errorHandle, OCI_DEFAULT);
+        Py_END_ALLOW_THREADS
+        if (Environment_CheckForError(connection->environment, status,
+                "SessionPool_Release(): rollback") < 0) {
+            if (!(mode & OCI_SESSRLS_DROPSESS))
+                return NULL;
+            PyErr_Clear();
+        }
+        connection->transactionInProgress = 0;
     }
 
-    // release the connection
+    // release the connection, tagging the session if a tag was specified
+    if (tagObj == Py_None)
+        tagObj = NULL;
+    if (cxBuffer_FromObject(&tagBuffer, tagObj,
+            connection->environment->encoding) < 0)
+        return NULL;
+    if (tagObj)
+        mode |= OCI_SESSRLS_RETAG;
     Py_BEGIN_ALLOW_THREADS
     status = OCISessionRelease(connection->handle,
-            connection->environment->errorHandle, NULL, 0, mode);
+            connection->environment->errorHandle, (OraText*) tagBuffer.ptr,
+            tagBuffer.size, mode);
     Py_END_ALLOW_THREADS
+    cxBuffer_Clear(&tagBuffer);
     if (Environment_CheckForError(connection->environment, status,
             "SessionPool_Release(): release session") < 0)
         return NULL;
+    if (mode & OCI_SESSRLS_DROPSESS)
+        self->stats.drops++;
+    else self->stats.releases++;
 
     // ensure that the connection behaves as closed
     Py_DECREF(connection->sessionPool);
@@ -456,7 +787,8 @@ static PyObject *SessionPool_Drop(
     udt_SessionPool *self,              // session pool
     PyObject *args)                     // arguments
 {
-    return SessionPool_InternalRelease(self, args, OCI_SESSRLS_DROPSESS);
+    return SessionPool_InternalRelease(self, args, NULL,
+            OCI_SESSRLS_DROPSESS);
 }
 
 
@@ -466,9 +798,173 @@ static PyObject *SessionPool_Drop(
 //-----------------------------------------------------------------------------
 static PyObject *SessionPool_Release(
     udt_SessionPool *self,              // session pool
-    PyObject *args)                     // arguments
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
 {
-    return SessionPool_InternalRelease(self, args, OCI_DEFAULT);
+    return SessionPool_InternalRelease(self, args, keywordArgs, OCI_DEFAULT);
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_ReleaseAll()
+//   Release all of the connections in the list back to the pool, tagging them
+// if a tag is specified or dropping them if the mode requests it. If an
+// exception is already set, it is preserved and any errors raised while
+// releasing are ignored.
+//-----------------------------------------------------------------------------
+static int SessionPool_ReleaseAll(
+    udt_SessionPool *self,              // session pool
+    PyObject *connections,              // list of connections to release
+    PyObject *tagObj,                   // tag to apply (or NULL)
+    ub4 mode)                           // OCI mode to use
+{
+    PyObject *releaseArgs, *result, *type, *value, *traceback;
+    Py_ssize_t i;
+    int status;
+
+    status = 0;
+    PyErr_Fetch(&type, &value, &traceback);
+    for (i = 0; i < PyList_GET_SIZE(connections); i++) {
+        if (tagObj)
+            releaseArgs = PyTuple_Pack(2, PyList_GET_ITEM(connections, i),
+                    tagObj);
+        else releaseArgs = PyTuple_Pack(1, PyList_GET_ITEM(connections, i));
+        if (!releaseArgs)
+            result = NULL;
+        else {
+            result = SessionPool_InternalRelease(self, releaseArgs, NULL,
+                    mode);
+            Py_DECREF(releaseArgs);
+        }
+        if (result)
+            Py_DECREF(result);
+        else if (type || status < 0)
+            PyErr_Clear();
+        else status = -1;
+    }
+    if (type)
+        PyErr_Restore(type, value, traceback);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_Warmup()
+//   Acquire the given number of sessions from the pool at the same time so
+// that the pool opens them now rather than when they are first needed,
+// optionally executing a statement on each of them (such as one which sets
+// up session state) and tagging them when they are released back to the
+// pool. Sessions on which the statement fails are dropped rather than tagged
+// since their state is unknown. The number of sessions is limited to those
+// the pool can still provide. The number of sessions opened by the pool is
+// returned.
+//-----------------------------------------------------------------------------
+static PyObject *SessionPool_Warmup(
+    udt_SessionPool *self,              // session pool
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "numSessions", "statement", "tag", NULL };
+    PyObject *statement, *tagObj, *connections, *failed, *cursor, *result;
+    ub4 openedBefore, openedAfter, busy, available, purity;
+    int numSessions, executed, i;
+    udt_Connection *connection;
+    sword status;
+
+    // parse arguments
+    numSessions = -1;
+    statement = tagObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|iOO", keywordList,
+            &numSessions, &statement, &tagObj))
+        return NULL;
+    if (statement == Py_None)
+        statement = NULL;
+    if (tagObj == Py_None)
+        tagObj = NULL;
+    if (numSessions < 0)
+        numSessions = (int) self->minSessions;
+
+    // make sure session pool is connected
+    if (SessionPool_IsConnected(self) < 0)
+        return NULL;
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL, &openedBefore, 0,
+            OCI_ATTR_SPOOL_OPEN_COUNT, self->environment->errorHandle);
+    if (Environment_CheckForError(self->environment, status,
+            "SessionPool_Warmup(): get open count") < 0)
+        return NULL;
+
+    // limit the number of sessions to those which are not already busy
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL, &busy, 0,
+            OCI_ATTR_SPOOL_BUSY_COUNT, self->environment->errorHandle);
+    if (Environment_CheckForError(self->environment, status,
+            "SessionPool_Warmup(): get busy count") < 0)
+        return NULL;
+    available = (busy < self->maxSessions) ? self->maxSessions - busy : 0;
+    if ((ub4) numSessions > available)
+        numSessions = (int) available;
+
+    // acquire the sessions, executing the statement on each, if applicable
+    purity = 0;
+#ifdef ORACLE_11G
+    purity = OCI_ATTR_PURITY_DEFAULT;
+#endif
+    connections = PyList_New(0);
+    if (!connections)
+        return NULL;
+    failed = PyList_New(0);
+    if (!failed) {
+        Py_DECREF(connections);
+        return NULL;
+    }
+    for (i = 0; i < numSessions; i++) {
+        connection = Connection_NewFromPool(self, NULL, purity, NULL, 0,
+                0, 0);
+        if (!connection)
+            break;
+        executed = 1;
+        if (statement) {
+            executed = 0;
+            cursor = Connection_NewCursor(connection, NULL, NULL);
+            if (cursor) {
+                result = PyObject_CallMethod(cursor, "execute", "O",
+                        statement);
+                Py_DECREF(cursor);
+                if (result) {
+                    Py_DECREF(result);
+                    executed = 1;
+                }
+            }
+        }
+        if (PyList_Append((executed) ? connections : failed,
+                (PyObject*) connection) < 0) {
+            Py_DECREF(connection);
+            break;
+        }
+        Py_DECREF(connection);
+        if (!executed)
+            break;
+    }
+
+    // drop the sessions on which the statement failed and release the others
+    // back to the pool
+    status = SessionPool_ReleaseAll(self, failed, NULL, OCI_SESSRLS_DROPSESS);
+    Py_DECREF(failed);
+    if (SessionPool_ReleaseAll(self, connections, tagObj, OCI_DEFAULT) < 0 ||
+            status < 0 || PyErr_Occurred()) {
+        Py_DECREF(connections);
+        return NULL;
+    }
+    Py_DECREF(connections);
+
+    // determine the number of sessions opened
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL, &openedAfter, 0,
+            OCI_ATTR_SPOOL_OPEN_COUNT, self->environment->errorHandle);
+    if (Environment_CheckForError(self->environment, status,
+            "SessionPool_Warmup(): get open count") < 0)
+        return NULL;
+    if (openedAfter < openedBefore)
+        openedAfter = openedBefore;
+    return PyInt_FromLong(openedAfter - openedBefore);
 }
 
 
@@ -531,3 +1027,180 @@ static int SessionPool_SetOCIAttr(
     return 0;
 }
 
+
+//-----------------------------------------------------------------------------
+// SessionPool_GetTime()
+//   Return the value of a clock in microseconds, used for measuring how long
+// it takes to acquire sessions from the pool.
+//-----------------------------------------------------------------------------
+static PY_LONG_LONG SessionPool_GetTime(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (PY_LONG_LONG) (counter.QuadPart / frequency.QuadPart) * 1000000 +
+            (PY_LONG_LONG) (counter.QuadPart % frequency.QuadPart) * 1000000 /
+            frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec value;
+
+    clock_gettime(CLOCK_MONOTONIC, &value);
+    return (PY_LONG_LONG) value.tv_sec * 1000000 + value.tv_nsec / 1000;
+#else
+    struct timeval value;
+
+    gettimeofday(&value, NULL);
+    return (PY_LONG_LONG) value.tv_sec * 1000000 + value.tv_usec;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_Sleep()
+//   Suspend the calling thread for the given number of milliseconds. This is
+// called with the global interpreter lock released.
+//-----------------------------------------------------------------------------
+static void SessionPool_Sleep(
+    unsigned milliseconds)              // time to sleep
+{
+#ifdef _WIN32
+    Sleep(milliseconds);
+#else
+    struct timespec value;
+
+    value.tv_sec = milliseconds / 1000;
+    value.tv_nsec = (milliseconds % 1000) * 1000000;
+    nanosleep(&value, NULL);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_AcquireCompleted()
+//   Update the statistics of the pool after a session was acquired from it or
+// the acquisition failed, in which case the exception is expected to be set.
+// Only attributes of the pool handle are consulted so no round trip to the
+// server is required.
+//-----------------------------------------------------------------------------
+static void SessionPool_AcquireCompleted(
+    udt_SessionPool *self,              // session pool
+    int acquireResult,                  // 0 if acquired, -1 on error
+    PY_LONG_LONG waitTime)              // time spent acquiring (microseconds)
+{
+    udt_SessionPoolStats *stats = &self->stats;
+    ub4 busy, opened, i;
+    sword status;
+    sb4 code;
+
+    // record the time spent waiting
+    if (waitTime < 0)
+        waitTime = 0;
+    stats->totalWaitTime += waitTime;
+    if (waitTime > stats->maxWaitTime)
+        stats->maxWaitTime = waitTime;
+    for (i = 0; i < NUM_ACQUIRE_WAIT_BUCKETS; i++) {
+        if (waitTime < gc_AcquireWaitBuckets[i])
+            break;
+    }
+    stats->waitHistogram[i]++;
+
+    // record errors, distinguishing the pool timing out or being exhausted
+    if (acquireResult < 0) {
+        stats->acquireErrors++;
+        code = SessionPool_GetErrorCode();
+        if (code == 24457)
+            stats->timeouts++;
+        else if (code == 24418)
+            stats->exhausted++;
+        return;
+    }
+
+    // record the number of busy sessions and whether a session was created
+    stats->acquires++;
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL, &busy, 0,
+            OCI_ATTR_SPOOL_BUSY_COUNT, self->environment->errorHandle);
+    if (status == OCI_SUCCESS && busy > stats->peakBusy)
+        stats->peakBusy = busy;
+    status = OCIAttrGet(self->handle, OCI_HTYPE_SPOOL, &opened, 0,
+            OCI_ATTR_SPOOL_OPEN_COUNT, self->environment->errorHandle);
+    if (status == OCI_SUCCESS && opened > stats->lastOpened)
+        stats->sessionsCreated += opened - stats->lastOpened;
+    else stats->sessionsReused++;
+    if (status == OCI_SUCCESS)
+        stats->lastOpened = opened;
+}
+
+
+//-----------------------------------------------------------------------------
+// SessionPool_GetStats()
+//   Return a dictionary containing the statistics gathered by the pool,
+// optionally resetting them afterwards. Times are returned in seconds.
+//-----------------------------------------------------------------------------
+static PyObject *SessionPool_GetStats(
+    udt_SessionPool *self,              // session pool
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "reset", NULL };
+    udt_SessionPoolStats *stats = &self->stats;
+    PyObject *resetObj, *histogram, *bucket, *result;
+    ub4 i, lastOpened;
+    int reset;
+
+    // parse arguments
+    resetObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|O", keywordList,
+            &resetObj))
+        return NULL;
+    reset = 0;
+    if (resetObj) {
+        reset = PyObject_IsTrue(resetObj);
+        if (reset < 0)
+            return NULL;
+    }
+
+    // build the histogram of acquire wait times
+    histogram = PyList_New(NUM_ACQUIRE_WAIT_BUCKETS + 1);
+    if (!histogram)
+        return NULL;
+    for (i = 0; i <= NUM_ACQUIRE_WAIT_BUCKETS; i++) {
+        if (i < NUM_ACQUIRE_WAIT_BUCKETS)
+            bucket = Py_BuildValue("dk", gc_AcquireWaitBuckets[i] / 1000000.0,
+                    stats->waitHistogram[i]);
+        else bucket = Py_BuildValue("Ok", Py_None, stats->waitHistogram[i]);
+        if (!bucket) {
+            Py_DECREF(histogram);
+            return NULL;
+        }
+        PyList_SET_ITEM(histogram, i, bucket);
+    }
+
+    // build the result
+    result = Py_BuildValue("{s:k,s:k,s:k,s:k,s:k,s:k,s:k,s:k,s:k,s:d,s:d,s:N}",
+            "acquires", stats->acquires,
+            "acquireErrors", stats->acquireErrors,
+            "timeouts", stats->timeouts,
+            "exhausted", stats->exhausted,
+            "releases", stats->releases,
+            "drops", stats->drops,
+            "sessionsCreated", stats->sessionsCreated,
+            "sessionsReused", stats->sessionsReused,
+            "peakBusy", (unsigned long) stats->peakBusy,
+            "totalWaitTime", stats->totalWaitTime / 1000000.0,
+            "maxWaitTime", stats->maxWaitTime / 1000000.0,
+            "waitHistogram", histogram);
+    if (!result)
+        return NULL;
+
+    // reset the statistics, if applicable; the number of sessions opened is
+    // retained so that sessions created later are still detected
+    if (reset) {
+        lastOpened = stats->lastOpened;
+        memset(stats, 0, sizeof(udt_SessionPoolStats));
+        stats->lastOpened = lastOpened;
+    }
+
+    return result;
+}
@@ -9,6 +9,7 @@
 typedef struct {
     Variable_HEAD
     char *data;
+    udt_DynamicBuffer *overflow;
 } udt_StringVar;
 
 
@@ -22,6 +23,11 @@ static PyObject *StringVar_GetValue(udt_StringVar*, unsigned);
 static int StringVar_PostDefine(udt_StringVar*);
 #endif
 static ub4 StringVar_GetBufferSize(udt_StringVar*);
+static int StringVar_InitializeCapped(udt_StringVar*, udt_Cursor*);
+static void StringVar_FinalizeCapped(udt_StringVar*);
+static int StringVar_PreFetchCapped(udt_StringVar*);
+static int StringVar_SetCappedValue(udt_StringVar*, unsigned, PyObject*);
+static PyObject *StringVar_GetCappedValue(udt_StringVar*, unsigned);
 
 //-----------------------------------------------------------------------------
 // Python type declarations
@@ -204,6 +210,27 @@ static udt_VariableType vt_String = {
 };
 
 
+static udt_VariableType vt_CappedString = {
+    (InitializeProc) StringVar_InitializeCapped,
+    (FinalizeProc) StringVar_FinalizeCapped,
+    (PreDefineProc) NULL,
+    (PostDefineProc) NULL,
+    (PreFetchProc) StringVar_PreFetchCapped,
+    (IsNullProc) NULL,
+    (SetValueProc) StringVar_SetCappedValue,
+    (GetValueProc) StringVar_GetCappedValue,
+    (GetBufferSizeProc) StringVar_GetBufferSize,
+    &g_StringVarType,                   // Python type
+    SQLT_CHR,                           // Oracle type
+    SQLCS_IMPLICIT,                     // charset form
+    MAX_STRING_CHARS,                   // element length (default)
+    1,                                  // is character data
+    1,                                  // is variable length
+    0,                                  // can be copied
+    0                                   // can be in array
+};
+
+
 #if PY_MAJOR_VERSION < 3
 static udt_VariableType vt_NationalCharString = {
     (InitializeProc) StringVar_Initialize,
@@ -394,8 +421,8 @@ static PyObject *StringVar_GetValue(
         return PyUnicode_Decode(data, var->actualLength[pos],
                 var->environment->nencoding, NULL);
 #endif
-    return cxString_FromEncodedString(data, var->actualLength[pos],
-            var->environment->encoding);
+    return Environment_DecodeString(var->environment, data,
+            var->actualLength[pos]);
 }
 
 
@@ -434,3 +461,143 @@ static ub4 StringVar_GetBufferSize(
     return self->size;
 }
 
+
+//-----------------------------------------------------------------------------
+// StringVar_InitializeCapped()
+//   Initialize a variable into which strings larger than the space allocated
+// for each element may be fetched.
+//-----------------------------------------------------------------------------
+static int StringVar_InitializeCapped(
+    udt_StringVar *var,                 // variable to initialize
+    udt_Cursor *cursor)                 // cursor to use
+{
+    if (StringVar_Initialize(var, cursor) < 0)
+        return -1;
+    var->overflow = Variable_AllocateDynamicBuffers((udt_Variable*) var);
+    if (!var->overflow)
+        return -1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// StringVar_FinalizeCapped()
+//   Free the buffers used for values too large for the space allocated.
+//-----------------------------------------------------------------------------
+static void StringVar_FinalizeCapped(
+    udt_StringVar *var)                 // variable to free
+{
+    if (var->overflow) {
+        Variable_FreeDynamicBuffers((udt_Variable*) var, var->overflow);
+        var->overflow = NULL;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// StringVar_PreFetchCapped()
+//   Reset the overflow buffers prior to fetching; the memory already
+// allocated is retained.
+//-----------------------------------------------------------------------------
+static int StringVar_PreFetchCapped(
+    udt_StringVar *var)                 // variable to prepare
+{
+    ub4 i;
+
+    for (i = 0; i < var->allocatedElements; i++) {
+        var->overflow[i].length = 0;
+        var->overflow[i].pieceLength = 0;
+        var->overflow[i].numPieces = 0;
+        var->returnCode[i] = 0;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// StringVar_DefineCallback()
+//   Callback invoked by Oracle during a fetch to acquire the location into
+// which the next piece of a string is to be placed. The first piece is placed
+// in the space allocated for the element; if any further pieces are
+// required, the first piece is copied to the overflow buffer for the element
+// and the remaining pieces are placed after it. Note that this is called while
+// the GIL is released.
+//-----------------------------------------------------------------------------
+static sb4 StringVar_DefineCallback(
+    udt_StringVar *var,                 // variable being fetched into
+    OCIDefine *defineHandle,            // define handle
+    ub4 iteration,                      // row within the fetch
+    dvoid **bufferPtr,                  // location of piece (OUT)
+    ub4 **lengthPtr,                    // length of piece (OUT)
+    ub1 *piece,                         // piece being fetched
+    dvoid **indicatorPtr,               // indicator (OUT)
+    ub2 **returnCodePtr)                // return code (OUT)
+{
+    udt_DynamicBuffer *buffer;
+    char *data;
+
+    buffer = &var->overflow[iteration];
+    data = var->data + iteration * var->bufferSize;
+    buffer->numPieces++;
+    if (buffer->numPieces == 1) {
+        buffer->pieceLength = var->bufferSize;
+        *bufferPtr = data;
+    } else {
+        if (buffer->numPieces == 2) {
+            buffer->length = 0;
+            if (Variable_GrowDynamicBuffer(buffer,
+                    buffer->pieceLength + 1) < 0)
+                return OCI_ERROR;
+            memcpy(buffer->ptr, data, buffer->pieceLength);
+        }
+        buffer->length += buffer->pieceLength;
+        if (Variable_GrowDynamicBuffer(buffer, 1) < 0)
+            return OCI_ERROR;
+        buffer->pieceLength = buffer->allocatedLength - buffer->length;
+        *bufferPtr = buffer->ptr + buffer->length;
+    }
+    *lengthPtr = &buffer->pieceLength;
+    *indicatorPtr = &var->indicator[iteration];
+    *returnCodePtr = NULL;
+
+    return OCI_CONTINUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// StringVar_SetCappedValue()
+//   Set the value of the variable.
+//-----------------------------------------------------------------------------
+static int StringVar_SetCappedValue(
+    udt_StringVar *var,                 // variable to set value for
+    unsigned pos,                       // array position to set
+    PyObject *value)                    // value to set
+{
+    if (StringVar_SetValue(var, pos, value) < 0)
+        return -1;
+    var->overflow[pos].numPieces = 0;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// StringVar_GetCappedValue()
+//   Returns the value stored at the given array position, which may have been
+// placed in the overflow buffer if it was too large for the space allocated.
+//-----------------------------------------------------------------------------
+static PyObject *StringVar_GetCappedValue(
+    udt_StringVar *var,                 // variable to determine value for
+    unsigned pos)                       // array position
+{
+    udt_DynamicBuffer *buffer;
+
+    buffer = &var->overflow[pos];
+    if (buffer->numPieces == 0)
+        return StringVar_GetValue(var, pos);
+    if (buffer->numPieces == 1)
+        return Environment_DecodeString(var->environment,
+                var->data + pos * var->bufferSize, buffer->pieceLength);
+    return Environment_DecodeString(var->environment, buffer->ptr,
+            buffer->length + buffer->pieceLength);
+}
@@ -760,7 +760,8 @@ static PyObject *Subscription_RegisterQuery(
 
     // create cursor to perform query
     env = self->connection->environment;
-    cursor = (udt_Cursor*) Connection_NewCursor(self->connection, NULL);
+    cursor = (udt_Cursor*) Connection_NewCursor(self->connection, NULL,
+            NULL);
     if (!cursor)
         return NULL;
 
@@ -809,7 +810,7 @@ static PyObject *Subscription_RegisterQuery(
     }
 
     // perform define as needed
-    if (Cursor_PerformDefine(cursor) < 0) {
+    if (Cursor_PerformDefine(cursor, cursor->arraySize) < 0) {
         Py_DECREF(cursor);
         return NULL;
     }
@@ -824,7 +825,7 @@ static PyObject *Subscription_RegisterQuery(
     }
 
     // execute the query which registers it
-    if (Cursor_InternalExecute(cursor, 0) < 0) {
+    if (Cursor_InternalExecute(cursor, 0, OCI_DEFAULT) < 0) {
         Py_DECREF(cursor);
         return NULL;
     }
@@ -9,6 +9,7 @@
 typedef struct {
     Variable_HEAD
     OCIDateTime **data;
+    ub4 unitsPerSecond;
 } udt_TimestampVar;
 
 
@@ -73,6 +74,27 @@ static udt_VariableType vt_Timestamp = {
 };
 
 
+static udt_VariableType vt_TimestampAsEpoch = {
+    (InitializeProc) TimestampVar_Initialize,
+    (FinalizeProc) TimestampVar_Finalize,
+    (PreDefineProc) NULL,
+    (PostDefineProc) NULL,
+    (PreFetchProc) NULL,
+    (IsNullProc) NULL,
+    (SetValueProc) TimestampVar_SetValue,
+    (GetValueProc) TimestampVar_GetValue,
+    (GetBufferSizeProc) NULL,
+    &g_TimestampVarType,                // Python type
+    SQLT_TIMESTAMP,                     // Oracle type
+    SQLCS_IMPLICIT,                     // charset form
+    sizeof(OCIDateTime*),               // element length (default)
+    0,                                  // is character data
+    0,                                  // is variable length
+    1,                                  // can be copied
+    1                                   // can be in array
+};
+
+
 //-----------------------------------------------------------------------------
 // TimestampVar_Initialize()
 //   Initialize the variable.
@@ -84,6 +106,10 @@ static int TimestampVar_Initialize(
     sword status;
     ub4 i;
 
+    // values are returned relative to the epoch if requested
+    if (var->type == &vt_TimestampAsEpoch)
+        var->unitsPerSecond = cursor->timestampsAsEpoch;
+
     // initialize the LOB locators
     for (i = 0; i < var->allocatedElements; i++) {
         status = OCIDescriptorAlloc(var->environment->handle,
@@ -166,6 +192,27 @@ static PyObject *TimestampVar_GetValue(
     udt_TimestampVar *var,              // variable to determine value for
     unsigned pos)                       // array position
 {
-    return OracleTimestampToPythonDate(var->environment, var->data[pos]);
+    ub1 hour, minute, second, month, day;
+    udt_Environment *environment;
+    sword status;
+    ub4 fsecond;
+    sb2 year;
+
+    if (!var->unitsPerSecond)
+        return OracleTimestampToPythonDate(var->environment, var->data[pos]);
+
+    environment = var->environment;
+    status = OCIDateTimeGetDate(environment->handle, environment->errorHandle,
+            var->data[pos], &year, &month, &day);
+    if (Environment_CheckForError(environment, status,
+            "TimestampVar_GetValue(): date portion") < 0)
+        return NULL;
+    status = OCIDateTimeGetTime(environment->handle, environment->errorHandle,
+            var->data[pos], &hour, &minute, &second, &fsecond);
+    if (Environment_CheckForError(environment, status,
+            "TimestampVar_GetValue(): time portion") < 0)
+        return NULL;
+    return OracleDateToPythonEpoch(year, month, day, hour, minute, second,
+            fsecond, var->unitsPerSecond);
 }
 
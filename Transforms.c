@@ -77,6 +77,49 @@ static PyObject *OracleTimestampToPythonDate(
 }
 
 
+//-----------------------------------------------------------------------------
+// OracleDateToPythonEpoch()
+//   Return a Python integer given the components of an Oracle date or
+// timestamp, expressed as the number of units (of which there are the given
+// number per second) elapsed since the epoch, 1970-01-01 00:00:00.
+//-----------------------------------------------------------------------------
+static PyObject *OracleDateToPythonEpoch(
+    int year,                           // year
+    int month,                          // month
+    int day,                            // day
+    int hour,                           // hour
+    int minute,                         // minute
+    int second,                         // second
+    ub4 fsecond,                        // fractional seconds (nanoseconds)
+    ub4 unitsPerSecond)                 // units per second
+{
+    int era, yearOfEra, dayOfYear, dayOfEra;
+    PY_LONG_LONG seconds;
+
+    // determine the number of days since the epoch in the proleptic
+    // Gregorian calendar, using years that start in March so that the leap
+    // day is always the last day of the year
+    if (month <= 2)
+        year--;
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    seconds = (PY_LONG_LONG) era * 146097 + dayOfEra - 719468;
+    seconds = seconds * 86400 + hour * 3600 + minute * 60 + second;
+
+    // scale to the requested units, ensuring that the result fits
+    if (seconds > PY_LLONG_MAX / unitsPerSecond - 1 ||
+            seconds < PY_LLONG_MIN / unitsPerSecond + 1) {
+        PyErr_SetString(PyExc_OverflowError,
+                "date out of range for the requested epoch units");
+        return NULL;
+    }
+    return PyLong_FromLongLong(seconds * unitsPerSecond +
+            (PY_LONG_LONG) fsecond * unitsPerSecond / 1000000000);
+}
+
+
 //-----------------------------------------------------------------------------
 // OracleNumberToPythonFloat()
 //   Return a Python date object given an Oracle date.
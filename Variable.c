@@ -72,15 +72,39 @@ typedef struct _udt_VariableType {
 } udt_VariableType;
 
 
+//-----------------------------------------------------------------------------
+// buffer used for each row when data is fetched dynamically (in pieces); the
+// buffer grows as pieces are supplied by Oracle and is retained between
+// fetches; the memory is managed without the Python memory allocator since
+// pieces are requested while the GIL is released
+//-----------------------------------------------------------------------------
+#define DYNAMIC_BUFFER_INITIAL_SIZE     4096
+
+typedef struct {
+    char *ptr;
+    ub4 allocatedLength;
+    ub4 length;
+    ub4 pieceLength;
+    ub4 numPieces;
+} udt_DynamicBuffer;
+
+
 //-----------------------------------------------------------------------------
 // Declaration of common variable functions.
 //-----------------------------------------------------------------------------
+static udt_DynamicBuffer *Variable_AllocateDynamicBuffers(udt_Variable *);
+static void Variable_FreeDynamicBuffers(udt_Variable *, udt_DynamicBuffer *);
+static int Variable_GrowDynamicBuffer(udt_DynamicBuffer *, ub4);
 static void Variable_Free(udt_Variable *);
 static PyObject *Variable_Repr(udt_Variable *);
 static PyObject *Variable_ExternalCopy(udt_Variable *, PyObject *);
 static PyObject *Variable_ExternalSetValue(udt_Variable *, PyObject *);
 static PyObject *Variable_ExternalGetValue(udt_Variable *, PyObject *,
         PyObject *);
+static PyObject *Variable_ExternalSetValues(udt_Variable *, PyObject *,
+        PyObject *);
+static PyObject *Variable_ExternalGetValues(udt_Variable *, PyObject *,
+        PyObject *);
 static int Variable_InternalBind(udt_Variable *);
 static int Variable_Resize(udt_Variable *, unsigned);
 
@@ -110,6 +134,10 @@ static PyMethodDef g_VariableMethods[] = {
     { "setvalue", (PyCFunction) Variable_ExternalSetValue, METH_VARARGS },
     { "getvalue", (PyCFunction) Variable_ExternalGetValue,
               METH_VARARGS  | METH_KEYWORDS },
+    { "setvalues", (PyCFunction) Variable_ExternalSetValues,
+              METH_VARARGS  | METH_KEYWORDS },
+    { "getvalues", (PyCFunction) Variable_ExternalGetValues,
+              METH_VARARGS  | METH_KEYWORDS },
     { NULL }
 };
 
@@ -193,6 +221,76 @@ static int Variable_AllocateData(
 }
 
 
+//-----------------------------------------------------------------------------
+// Variable_AllocateDynamicBuffers()
+//   Allocate the buffers used for fetching data dynamically, one for each
+// element of the variable.
+//-----------------------------------------------------------------------------
+static udt_DynamicBuffer *Variable_AllocateDynamicBuffers(
+    udt_Variable *var)                  // variable to allocate buffers for
+{
+    udt_DynamicBuffer *buffers;
+
+    buffers = PyMem_Malloc(var->allocatedElements * sizeof(udt_DynamicBuffer));
+    if (!buffers) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memset(buffers, 0, var->allocatedElements * sizeof(udt_DynamicBuffer));
+    return buffers;
+}
+
+
+//-----------------------------------------------------------------------------
+// Variable_FreeDynamicBuffers()
+//   Free the buffers used for fetching data dynamically.
+//-----------------------------------------------------------------------------
+static void Variable_FreeDynamicBuffers(
+    udt_Variable *var,                  // variable buffers belong to
+    udt_DynamicBuffer *buffers)         // buffers to free
+{
+    ub4 i;
+
+    for (i = 0; i < var->allocatedElements; i++) {
+        if (buffers[i].ptr)
+            free(buffers[i].ptr);
+    }
+    PyMem_Free(buffers);
+}
+
+
+//-----------------------------------------------------------------------------
+// Variable_GrowDynamicBuffer()
+//   Ensure that the buffer has at least the given number of bytes available
+// beyond the data already placed in it. Note that this is called while the
+// GIL is released.
+//-----------------------------------------------------------------------------
+static int Variable_GrowDynamicBuffer(
+    udt_DynamicBuffer *buffer,          // buffer to grow
+    ub4 numBytes)                       // number of bytes required
+{
+    ub4 allocatedLength;
+    char *ptr;
+
+    if (buffer->allocatedLength - buffer->length >= numBytes)
+        return 0;
+    allocatedLength = buffer->allocatedLength;
+    if (allocatedLength < DYNAMIC_BUFFER_INITIAL_SIZE)
+        allocatedLength = DYNAMIC_BUFFER_INITIAL_SIZE;
+    while (allocatedLength - buffer->length < numBytes) {
+        if (allocatedLength > UB4MAXVAL / 2)
+            return -1;
+        allocatedLength *= 2;
+    }
+    ptr = realloc(buffer->ptr, allocatedLength);
+    if (!ptr)
+        return -1;
+    buffer->ptr = ptr;
+    buffer->allocatedLength = allocatedLength;
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // Variable_New()
 //   Allocate a new variable.
@@ -212,8 +310,8 @@ static udt_Variable *Variable_New(
         return NULL;
 
     // perform basic initialization
-    Py_INCREF(cursor->connection->environment);
-    self->environment = cursor->connection->environment;
+    Py_INCREF(cursor->environment);
+    self->environment = cursor->environment;
     self->boundCursorHandle = NULL;
     self->bindHandle = NULL;
     self->defineHandle = NULL;
@@ -602,7 +700,6 @@ static udt_VariableType *Variable_TypeByOracleDataType (
         case SQLT_VNU:
             return &vt_Float;
         case SQLT_DAT:
-        case SQLT_ODT:
             return &vt_DateTime;
         case SQLT_DATE:
         case SQLT_TIMESTAMP:
@@ -851,6 +948,26 @@ static udt_Variable *Variable_NewByType(
 }
 
 
+//-----------------------------------------------------------------------------
+// Variable_NewForDefine()
+//   Allocate a variable for defining a column when no output type handler
+// supplies one. If requested, the space allocated in advance for strings is
+// limited and longer values are fetched in pieces.
+//-----------------------------------------------------------------------------
+static udt_Variable *Variable_NewForDefine(
+    udt_Cursor *cursor,                 // cursor to associate variable with
+    unsigned numElements,               // number of elements
+    udt_VariableType *varType,          // variable type already chosen
+    ub4 size)                           // maximum size of variable
+{
+    if (varType == &vt_String && cursor->stringDefineSize > 0 &&
+            size > (ub4) cursor->stringDefineSize)
+        return Variable_New(cursor, numElements, &vt_CappedString,
+                cursor->stringDefineSize);
+    return Variable_New(cursor, numElements, varType, size);
+}
+
+
 //-----------------------------------------------------------------------------
 // Variable_NewByOutputTypeHandler()
 //   Create a new variable by calling the output type handler.
@@ -902,7 +1019,7 @@ static udt_Variable *Variable_NewByOutputTypeHandler(
     // if result is None, assume default behavior
     if (result == Py_None) {
         Py_DECREF(result);
-        return Variable_New(cursor, numElements, varType, size);
+        return Variable_NewForDefine(cursor, numElements, varType, size);
     }
 
     // otherwise, verify that the result is an actual variable
@@ -926,6 +1043,30 @@ static udt_Variable *Variable_NewByOutputTypeHandler(
 }
 
 
+//-----------------------------------------------------------------------------
+// Variable_DefineDynamic()
+//   Define the variable so that data is supplied in pieces by the given
+// callback rather than placed directly in the variable's buffer.
+//-----------------------------------------------------------------------------
+static sword Variable_DefineDynamic(
+    udt_Variable *var,                  // variable to define
+    udt_Cursor *cursor,                 // cursor in use
+    unsigned position,                  // position in define list
+    sb4 maxSize,                        // maximum size of data
+    OCICallbackDefine callback)         // callback supplying pieces
+{
+    sword status;
+
+    status = OCIDefineByPos(cursor->handle, &var->defineHandle,
+            var->environment->errorHandle, position, NULL, maxSize,
+            var->type->oracleType, NULL, NULL, NULL, OCI_DYNAMIC_FETCH);
+    if (status != OCI_SUCCESS)
+        return status;
+    return OCIDefineDynamic(var->defineHandle, var->environment->errorHandle,
+            (dvoid*) var, callback);
+}
+
+
 //-----------------------------------------------------------------------------
 // Variable_DefineHelper()
 //   Helper routine for Variable_Define() used so that constant calls to
@@ -938,10 +1079,14 @@ static udt_Variable *Variable_DefineHelper(
     unsigned numElements)               // number of elements to create
 {
     udt_VariableType *varType;
+    ub4 size;
     ub2 sizeFromOracle;
     udt_Variable *var;
+#ifdef SQLT_BFLOAT
+    sb2 precision;
+    sb1 scale;
+#endif
     sword status;
-    ub4 size;
 
     // determine data type
     varType = Variable_TypeByOracleDescriptor(param, cursor->environment);
@@ -949,6 +1094,36 @@ static udt_Variable *Variable_DefineHelper(
         return NULL;
     if (cursor->numbersAsStrings && varType == &vt_Float)
         varType = &vt_NumberAsString;
+#ifdef SQLT_BFLOAT
+
+    // if requested, have Oracle convert non-integral numbers to native
+    // doubles directly; integral numbers continue to be returned as integers
+    else if (cursor->numbersAsNativeFloats && varType == &vt_Float) {
+        if (NumberVar_GetPrecisionAndScale(cursor->environment, param,
+                &precision, &scale) < 0)
+            return NULL;
+        if (scale != 0 && (scale != -127 || precision != 0))
+            varType = &vt_NativeFloat;
+    }
+#endif
+
+    // if requested, fetch long data in pieces rather than into a buffer large
+    // enough for the largest value expected
+    if (cursor->dynamicLongs) {
+        if (varType == &vt_LongString)
+            varType = &vt_DynamicLongString;
+        else if (varType == &vt_LongBinary)
+            varType = &vt_DynamicLongBinary;
+    }
+
+    // if requested, return dates and timestamps as integers relative to the
+    // epoch instead of creating datetime objects
+    if (cursor->timestampsAsEpoch > 0) {
+        if (varType == &vt_DateTime)
+            varType = &vt_DateTimeAsEpoch;
+        else if (varType == &vt_Timestamp)
+            varType = &vt_TimestampAsEpoch;
+    }
 
     // retrieve size of the parameter
     size = varType->size;
@@ -983,7 +1158,7 @@ static udt_Variable *Variable_DefineHelper(
         var = Variable_NewByOutputTypeHandler(cursor, param,
                 cursor->connection->outputTypeHandler, varType, size,
                 numElements);
-    else var = Variable_New(cursor, numElements, varType, size);
+    else var = Variable_NewForDefine(cursor, numElements, varType, size);
     if (!var)
         return NULL;
 
@@ -995,8 +1170,17 @@ static udt_Variable *Variable_DefineHelper(
         }
     }
 
-    // perform the define
-    status = OCIDefineByPos(cursor->handle, &var->defineHandle,
+    // perform the define; data fetched dynamically is supplied in pieces by
+    // callback instead of being placed directly in the variable's buffer
+    if (var->type == &vt_DynamicLongString ||
+            var->type == &vt_DynamicLongBinary)
+        status = Variable_DefineDynamic(var, cursor, position, SB4MAXVAL,
+                (OCICallbackDefine) LongVar_DefineCallback);
+    else if (var->type == &vt_CappedString)
+        status = Variable_DefineDynamic(var, cursor, position,
+                size * cursor->environment->maxBytesPerCharacter,
+                (OCICallbackDefine) StringVar_DefineCallback);
+    else status = OCIDefineByPos(cursor->handle, &var->defineHandle,
             var->environment->errorHandle, position, var->data,
             var->bufferSize, var->type->oracleType, var->indicator,
             var->actualLength, var->returnCode, OCI_DEFAULT);
@@ -1366,6 +1550,100 @@ static int Variable_SetValue(
 }
 
 
+//-----------------------------------------------------------------------------
+// Variable_CopyDescriptor()
+//   Copy the descriptor at the given position in the source variable into the
+// descriptor at the given position in the target variable. Timestamps and
+// intervals are held as pointers to descriptors owned by each variable so the
+// values must be assigned rather than the pointers copied.
+//-----------------------------------------------------------------------------
+static int Variable_CopyDescriptor(
+    udt_Variable *targetVar,            // variable to copy to
+    unsigned targetPos,                 // array position to copy to
+    udt_Variable *sourceVar,            // variable to copy from
+    unsigned sourcePos)                 // array position to copy from
+{
+    udt_Environment *environment;
+    sword status;
+
+    environment = targetVar->environment;
+    if (sourceVar->type->oracleType == SQLT_INTERVAL_DS)
+        status = OCIIntervalAssign(environment->handle,
+                environment->errorHandle,
+                ((udt_IntervalVar*) sourceVar)->data[sourcePos],
+                ((udt_IntervalVar*) targetVar)->data[targetPos]);
+    else status = OCIDateTimeAssign(environment->handle,
+                environment->errorHandle,
+                ((udt_TimestampVar*) sourceVar)->data[sourcePos],
+                ((udt_TimestampVar*) targetVar)->data[targetPos]);
+    return Environment_CheckForError(environment, status,
+            "Variable_CopyDescriptor()");
+}
+
+
+//-----------------------------------------------------------------------------
+// Variable_CopyElements()
+//   Copy a range of elements from the source variable to the target variable.
+// The variables are assumed to be of the same type, to support copying and to
+// have sufficient elements; the target buffer size must be at least as large
+// as the source buffer size. When the buffer sizes match, the data is copied
+// in a single block; descriptors are copied one element at a time.
+//-----------------------------------------------------------------------------
+static int Variable_CopyElements(
+    udt_Variable *targetVar,            // variable to copy to
+    unsigned targetPos,                 // first array position to copy to
+    udt_Variable *sourceVar,            // variable to copy from
+    unsigned sourcePos,                 // first array position to copy from
+    unsigned numElements)               // number of elements to copy
+{
+    unsigned i;
+
+    // verify that the source data was fetched without error
+    for (i = 0; i < numElements; i++) {
+        if (sourceVar->indicator[sourcePos + i] != OCI_IND_NULL &&
+                Variable_VerifyFetch(sourceVar, sourcePos + i) < 0)
+            return -1;
+    }
+
+    // copy the indicators, lengths and return codes
+    memcpy(&targetVar->indicator[targetPos], &sourceVar->indicator[sourcePos],
+            numElements * sizeof(sb2));
+    if (targetVar->actualLength)
+        memcpy(&targetVar->actualLength[targetPos],
+                &sourceVar->actualLength[sourcePos],
+                numElements * sizeof(ub2));
+    if (targetVar->returnCode)
+        memcpy(&targetVar->returnCode[targetPos],
+                &sourceVar->returnCode[sourcePos],
+                numElements * sizeof(ub2));
+
+    // copy the data
+    if (sourceVar->type->oracleType == SQLT_TIMESTAMP ||
+            sourceVar->type->oracleType == SQLT_INTERVAL_DS) {
+        for (i = 0; i < numElements; i++) {
+            if (sourceVar->indicator[sourcePos + i] == OCI_IND_NULL)
+                continue;
+            if (Variable_CopyDescriptor(targetVar, targetPos + i, sourceVar,
+                    sourcePos + i) < 0)
+                return -1;
+        }
+    } else if (targetVar->bufferSize == sourceVar->bufferSize)
+        memcpy( (char*) targetVar->data + targetPos * targetVar->bufferSize,
+                (char*) sourceVar->data + sourcePos * sourceVar->bufferSize,
+                numElements * sourceVar->bufferSize);
+    else {
+        for (i = 0; i < numElements; i++)
+            memcpy( (char*) targetVar->data +
+                            (targetPos + i) * targetVar->bufferSize,
+                    (char*) sourceVar->data +
+                            (sourcePos + i) * sourceVar->bufferSize,
+                    sourceVar->bufferSize);
+    }
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // Variable_ExternalCopy()
 //   Copy the contents of the source variable to the destination variable.
@@ -1410,25 +1688,10 @@ static PyObject *Variable_ExternalCopy(
         return NULL;
     }
 
-    // handle null case directly
-    if (sourceVar->indicator[sourcePos] == OCI_IND_NULL)
-        targetVar->indicator[targetPos] = OCI_IND_NULL;
-
-    // otherwise, copy data
-    else {
-        targetVar->indicator[targetPos] = OCI_IND_NOTNULL;
-        if (Variable_VerifyFetch(sourceVar, sourcePos) < 0)
-            return NULL;
-        if (targetVar->actualLength)
-            targetVar->actualLength[targetPos] =
-                    sourceVar->actualLength[sourcePos];
-        if (targetVar->returnCode)
-            targetVar->returnCode[targetPos] =
-                    sourceVar->returnCode[sourcePos];
-        memcpy( (char*) targetVar->data + targetPos * targetVar->bufferSize,
-                (char*) sourceVar->data + sourcePos * sourceVar->bufferSize,
-                sourceVar->bufferSize);
-    }
+    // copy the data
+    if (Variable_CopyElements(targetVar, targetPos, sourceVar, sourcePos,
+            1) < 0)
+        return NULL;
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1475,6 +1738,121 @@ static PyObject *Variable_ExternalGetValue(
 }
 
 
+//-----------------------------------------------------------------------------
+// Variable_ExternalSetValues()
+//   Set the values of the variable for a range of positions starting at the
+// given position from the items in the sequence. For array variables the
+// number of elements in the array is extended, if needed, to include the
+// positions that were set.
+//-----------------------------------------------------------------------------
+static PyObject *Variable_ExternalSetValues(
+    udt_Variable *var,                  // variable to set
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "sequence", "start", NULL };
+    PyObject *sequence, *values;
+    unsigned start, numElements, i;
+
+    // parse arguments
+    start = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|i", keywordList,
+            &sequence, &start))
+        return NULL;
+    values = PySequence_Fast(sequence, "expecting a sequence");
+    if (!values)
+        return NULL;
+
+    // ensure we haven't exceeded the number of allocated elements
+    numElements = (unsigned) PySequence_Fast_GET_SIZE(values);
+    if (start > var->allocatedElements ||
+            numElements > var->allocatedElements - start) {
+        Py_DECREF(values);
+        PyErr_SetString(PyExc_IndexError,
+                "Variable_SetValues: array size exceeded");
+        return NULL;
+    }
+
+    // set all of the values
+    for (i = 0; i < numElements; i++) {
+        if (Variable_SetSingleValue(var, start + i,
+                PySequence_Fast_GET_ITEM(values, i)) < 0) {
+            Py_DECREF(values);
+            return NULL;
+        }
+    }
+    Py_DECREF(values);
+    if (var->isArray && start + numElements > var->actualElements)
+        var->actualElements = start + numElements;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+
+//-----------------------------------------------------------------------------
+// Variable_ExternalGetValues()
+//   Return a list of the values of the variable for a range of positions. If
+// no count is specified, all of the values from the start position to the end
+// of the variable (or the end of the array for array variables) are returned.
+//-----------------------------------------------------------------------------
+static PyObject *Variable_ExternalGetValues(
+    udt_Variable *var,                  // variable to get values from
+    PyObject *args,                     // arguments
+    PyObject *keywordArgs)              // keyword arguments
+{
+    static char *keywordList[] = { "start", "count", NULL };
+    PyObject *countObj, *values, *value;
+    unsigned start, numElements, i;
+    ub4 maxElements;
+    long count;
+
+    // parse arguments
+    start = 0;
+    countObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|iO", keywordList,
+            &start, &countObj))
+        return NULL;
+
+    // determine the number of values to return
+    maxElements = (var->isArray) ? var->actualElements :
+            var->allocatedElements;
+    if (start > maxElements) {
+        PyErr_SetString(PyExc_IndexError,
+                "Variable_GetValues: array size exceeded");
+        return NULL;
+    }
+    if (!countObj || countObj == Py_None)
+        numElements = maxElements - start;
+    else {
+        count = PyInt_AsLong(countObj);
+        if (PyErr_Occurred())
+            return NULL;
+        if (count < 0 || (unsigned long) count > maxElements - start) {
+            PyErr_SetString(PyExc_IndexError,
+                    "Variable_GetValues: array size exceeded");
+            return NULL;
+        }
+        numElements = (unsigned) count;
+    }
+
+    // build the list of values
+    values = PyList_New(numElements);
+    if (!values)
+        return NULL;
+    for (i = 0; i < numElements; i++) {
+        value = Variable_GetSingleValue(var, start + i);
+        if (!value) {
+            Py_DECREF(values);
+            return NULL;
+        }
+        PyList_SET_ITEM(values, i, value);
+    }
+
+    return values;
+}
+
+
 //-----------------------------------------------------------------------------
 // Variable_Repr()
 //   Return a string representation of the variable.
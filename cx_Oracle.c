@@ -7,6 +7,11 @@
 #include <datetime.h>
 #include <structmember.h>
 #include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
 #include <oci.h>
 #include <orid.h>
 #include <xa.h>
@@ -44,6 +49,11 @@ typedef int Py_ssize_t;
 #define Py_TYPE(ob)             (((PyObject*)(ob))->ob_type)
 #endif
 
+// define Py_REFCNT for versions before Python 2.6
+#ifndef Py_REFCNT
+#define Py_REFCNT(ob)           (((PyObject*)(ob))->ob_refcnt)
+#endif
+
 // define PyVarObject_HEAD_INIT for versions before Python 2.6
 #ifndef PyVarObject_HEAD_INIT
 #define PyVarObject_HEAD_INIT(type, size) \
@@ -196,6 +206,7 @@ static int GetModuleAndName(
 
 #include "Environment.c"
 #include "SessionPool.c"
+#include "PoolGroup.c"
 
 
 //-----------------------------------------------------------------------------
@@ -374,8 +385,10 @@ static PyObject *Module_Initialize(void)
     // prepare the types for use by the module
     MAKE_TYPE_READY(&g_ConnectionType);
     MAKE_TYPE_READY(&g_CursorType);
+    MAKE_TYPE_READY(&g_CursorIteratorType);
     MAKE_TYPE_READY(&g_ErrorType);
     MAKE_TYPE_READY(&g_SessionPoolType);
+    MAKE_TYPE_READY(&g_PoolGroupType);
     MAKE_TYPE_READY(&g_EnvironmentType);
     MAKE_TYPE_READY(&g_ObjectTypeType);
     MAKE_TYPE_READY(&g_ObjectAttributeType);
@@ -459,6 +472,7 @@ static PyObject *Module_Initialize(void)
     ADD_TYPE_OBJECT("Timestamp", PyDateTimeAPI->DateTimeType)
     ADD_TYPE_OBJECT("Date", PyDateTimeAPI->DateType)
     ADD_TYPE_OBJECT("SessionPool", &g_SessionPoolType)
+    ADD_TYPE_OBJECT("PoolGroup", &g_PoolGroupType)
     ADD_TYPE_OBJECT("_Error", &g_ErrorType)
 
     // the name "connect" is required by the DB API
@@ -521,6 +535,20 @@ static PyObject *Module_Initialize(void)
     ADD_OCI_CONSTANT(SPOOL_ATTRVAL_WAIT)
     ADD_OCI_CONSTANT(SPOOL_ATTRVAL_NOWAIT)
     ADD_OCI_CONSTANT(SPOOL_ATTRVAL_FORCEGET)
+#ifdef OCI_SPOOL_ATTRVAL_TIMEDWAIT
+    ADD_OCI_CONSTANT(SPOOL_ATTRVAL_TIMEDWAIT)
+#endif
+
+    // add constants for the policies of pool groups
+    if (PyModule_AddIntConstant(module, "POOLGROUP_LEASTBUSY",
+            POOLGROUP_LEASTBUSY) < 0)
+        return NULL;
+    if (PyModule_AddIntConstant(module, "POOLGROUP_ROUNDROBIN",
+            POOLGROUP_ROUNDROBIN) < 0)
+        return NULL;
+    if (PyModule_AddIntConstant(module, "POOLGROUP_WEIGHTED",
+            POOLGROUP_WEIGHTED) < 0)
+        return NULL;
 #ifdef ORACLE_10GR2
     ADD_OCI_CONSTANT(PRELIM_AUTH)
     ADD_OCI_CONSTANT(DBSHUTDOWN_ABORT)
@@ -324,7 +324,7 @@ extension = Extension(
                 "CursorVar.c", "DateTimeVar.c", "Environment.c", "Error.c",
                 "ExternalLobVar.c", "ExternalObjectVar.c", "IntervalVar.c",
                 "LobVar.c", "LongVar.c", "NumberVar.c", "ObjectType.c",
-                "ObjectVar.c", "SessionPool.c", "StringVar.c",
+                "ObjectVar.c", "PoolGroup.c", "SessionPool.c", "StringVar.c",
                 "Subscription.c", "TimestampVar.c", "Transforms.c",
                 "Variable.c"])
 
@@ -1,5 +1,6 @@
 """Module for testing connections."""
 
+import sys
 import threading
 
 class TestConnection(TestCase):
@@ -13,6 +14,19 @@ class TestConnection(TestCase):
         count, = cursor.fetchone()
         self.failUnlessEqual(count, 10)
 
+    def __QueryWithCursor(self, connection, errors):
+        """Query and raise an error on a new cursor of a shared connection."""
+        try:
+            cursor = connection.cursor()
+            for i in range(10):
+                cursor.execute("select count(*) from TestNumbers")
+                count, = cursor.fetchone()
+                self.failUnlessEqual(count, 10)
+                self.failUnlessRaises(cx_Oracle.DatabaseError, cursor.execute,
+                        "select 1 / 0 from dual")
+        except:
+            errors.append(sys.exc_info())
+
     def setUp(self):
         self.username = USERNAME
         self.password = PASSWORD
@@ -46,6 +60,35 @@ class TestConnection(TestCase):
         self.failUnlessRaises(cx_Oracle.DatabaseError, cx_Oracle.connect,
                 self.username, self.password + "X", self.tnsentry)
 
+    def testLazyConnect(self):
+        "connection to database is deferred until first use"
+        connection = cx_Oracle.connect(self.username, self.password + "X",
+                self.tnsentry, lazy = True)
+        cursor = connection.cursor()
+        self.failUnlessRaises(cx_Oracle.DatabaseError, cursor.execute,
+                "select count(*) from TestNumbers")
+        connection.close()
+        connection = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, lazy = True)
+        cursor = connection.cursor()
+        cursor.execute("select count(*) from TestNumbers")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+
+    def testLazyConnectVariables(self):
+        "variables needing the database connect a lazy connection"
+        connection = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, lazy = True)
+        cursor = connection.cursor()
+        var = cursor.var(cx_Oracle.OBJECT, typename = "UDT_OBJECT")
+        self.failUnlessEqual(var.type.name, "UDT_OBJECT")
+        connection = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, lazy = True)
+        cursor = connection.cursor()
+        var = cursor.var(cx_Oracle.CLOB)
+        var.setvalue(0, "Lazy value")
+        self.failUnlessEqual(var.getvalue().read(), "Lazy value")
+
     def testExceptionOnClose(self):
         "confirm an exception is raised after closing a connection"
         connection = cx_Oracle.connect(self.username, self.password,
@@ -104,6 +147,43 @@ class TestConnection(TestCase):
         count, = cursor.fetchone()
         self.failUnlessEqual(count, 0)
 
+    def testSharedEnvironment(self):
+        "threaded connections share an environment and survive its users"
+        self.failUnlessRaises(cx_Oracle.DatabaseError, cx_Oracle.connect,
+                self.username, self.password + "X", self.tnsentry,
+                threaded = True)
+        connection_1 = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, threaded = True)
+        connection_2 = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, threaded = True)
+        self.failUnlessEqual(connection_1.encoding, connection_2.encoding)
+        cursor = connection_1.cursor()
+        cursor.execute("select count(*) from TestNumbers")
+        connection_2.close()
+        del connection_2
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+        connection_2 = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, threaded = True)
+        cursor = connection_2.cursor()
+        cursor.execute("select count(*) from TestNumbers")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+
+    def testSharedEnvironmentEncodings(self):
+        "threaded connections with different encodings do not share them"
+        connection_1 = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, threaded = True, encoding = "UTF-8")
+        connection_2 = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, threaded = True, encoding = "ASCII")
+        self.failUnlessEqual(connection_1.encoding, "UTF-8")
+        self.failUnlessEqual(connection_2.encoding, "ASCII")
+        connection_1.close()
+        cursor = connection_2.cursor()
+        cursor.execute("select count(*) from TestNumbers")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+
     def testThreading(self):
         "connection to database with multiple threads"
         threads = []
@@ -114,3 +194,20 @@ class TestConnection(TestCase):
         for thread in threads:
             thread.join()
 
+    def testThreadedCursors(self):
+        "cursors of one connection used concurrently by multiple threads"
+        connection = cx_Oracle.connect(self.username, self.password,
+                self.tnsentry, threaded = True)
+        threads = []
+        errors = []
+        for i in range(10):
+            thread = threading.Thread(None, self.__QueryWithCursor,
+                    args = (connection, errors))
+            threads.append(thread)
+            thread.start()
+        for thread in threads:
+            thread.join()
+        if errors:
+            excType, excValue, excTraceback = errors[0]
+            raise excValue
+
@@ -155,6 +155,49 @@ class TestCursor(BaseTestCase):
                 statement, rows)
         self.failUnlessEqual(self.cursor.rowcount, 3)
 
+    def testCopyFrom(self):
+        """test copying rows from one cursor to another"""
+        self.cursor.execute("truncate table TestExecuteMany")
+        sourceCursor = self.connection.cursor()
+        sourceCursor.arraysize = 4
+        sourceCursor.execute("""
+                select IntCol, StringCol
+                from TestStrings
+                order by IntCol""")
+        sourceCursor.fetchone()
+        numRows = self.cursor.copyfrom(sourceCursor,
+                "insert into TestExecuteMany (IntCol, StringCol) " \
+                "values (:1, :2)", 3)
+        self.failUnlessEqual(numRows, 9)
+        self.failUnlessEqual(self.cursor.rowcount, 9)
+        self.failUnlessEqual(sourceCursor.fetchone(), None)
+        self.cursor.execute("""
+                select IntCol, StringCol
+                from TestExecuteMany
+                order by IntCol""")
+        self.failUnlessEqual(self.cursor.fetchall(),
+                [(i, "String %d" % i) for i in range(2, 11)])
+
+    def testCopyFromTimestamps(self):
+        """test copying rows containing timestamps from one cursor to another"""
+        self.cursor.execute("truncate table TestCopyTimestamps")
+        sql = """
+                select IntCol, TimestampCol, NullableCol
+                from %s
+                order by IntCol"""
+        self.cursor.execute(sql % "TestTimestamps")
+        expectedRows = self.cursor.fetchall()
+        sourceCursor = self.connection.cursor()
+        sourceCursor.arraysize = 4
+        sourceCursor.execute(sql % "TestTimestamps")
+        numRows = self.cursor.copyfrom(sourceCursor,
+                "insert into TestCopyTimestamps " \
+                "(IntCol, TimestampCol, NullableCol) values (:1, :2, :3)", 3)
+        self.failUnlessEqual(numRows, len(expectedRows))
+        sourceCursor.close()
+        self.cursor.execute(sql % "TestCopyTimestamps")
+        self.failUnlessEqual(self.cursor.fetchall(), expectedRows)
+
     def testPrepare(self):
         """test preparing a statement and executing it multiple times"""
         self.failUnlessEqual(self.cursor.statement, None)
@@ -207,6 +250,93 @@ class TestCursor(BaseTestCase):
         else:
             self.failUnlessRaises(cx_Oracle.InterfaceError, testIter.next) 
 
+    def testIteratorsReexecuted(self):
+        """test iterators (with intermediate execute of another query)"""
+        self.cursor.arraysize = 5
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                where IntCol between 1 and 3
+                order by IntCol""")
+        testIter = iter(self.cursor)
+        self.failUnless(testIter is not self.cursor)
+        self.failUnlessEqual([v for v, in testIter], [1, 2, 3])
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                where IntCol between 4 and 5
+                order by IntCol""")
+        self.failUnlessEqual([v for v, in testIter], [4, 5])
+        self.cursor.close()
+        self.failUnlessRaises(cx_Oracle.InterfaceError, list, testIter)
+
+    def testFetchInto(self):
+        """test fetchmany() and fetchall() appending to an existing list"""
+        self.cursor.arraysize = 3
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                where IntCol between 1 and 8
+                order by IntCol""")
+        rows = [(0,)]
+        result = self.cursor.fetchmany(2, into = rows)
+        self.failUnless(result is rows)
+        self.failUnlessEqual(rows, [(0,), (1,), (2,)])
+        self.failUnlessEqual(self.cursor.fetchmany(4),
+                [(3,), (4,), (5,), (6,)])
+        self.cursor.fetchall(into = rows)
+        self.failUnlessEqual(rows, [(0,), (1,), (2,), (7,), (8,)])
+        self.failUnlessEqual(self.cursor.fetchall(into = rows), rows)
+        self.failUnlessEqual(self.cursor.fetchall(), [])
+        self.failUnlessRaises(TypeError, self.cursor.fetchall, into = ())
+
+    def testFetchIntoBuffers(self):
+        """test fetching rows directly into buffers"""
+        if sys.version_info[0] < 3:
+            return
+        import array
+        self.cursor.arraysize = 3
+        self.cursor.execute("""
+                select IntCol, NullableCol
+                from TestNumbers
+                where IntCol between 1 and 7
+                order by IntCol""")
+        ids = array.array("q", [0] * 5)
+        values = array.array("d", [0] * 5)
+        nulls = [bytearray(5), bytearray(5)]
+        self.failUnlessEqual(self.cursor.fetchinto([ids, values], nulls), 5)
+        self.failUnlessEqual(list(ids), [1, 2, 3, 4, 5])
+        self.failUnlessEqual(list(nulls[1]), [0, 1, 0, 1, 0])
+        self.failUnlessEqual(values[:2], array.array("d", [143, 0]))
+        self.failUnlessEqual(self.cursor.rowcount, 5)
+        self.failUnlessEqual(self.cursor.fetchinto([ids, values], nulls), 2)
+        self.failUnlessEqual(list(ids[:2]), [6, 7])
+        self.failUnlessEqual(self.cursor.fetchinto([ids, values]), 0)
+        self.failUnlessRaises(cx_Oracle.InterfaceError,
+                self.cursor.fetchinto, [ids])
+
+    def testAggregate(self):
+        """test computing aggregates while fetching"""
+        self.cursor.arraysize = 4
+        self.cursor.execute("""
+                select IntCol, NullableCol, mod(IntCol, 2)
+                from TestNumbers""")
+        result = self.cursor.aggregate([("count", None), ("sum", 0),
+                ("min", 0), ("max", 0), ("count", 1)])
+        self.failUnlessEqual(result, (10, 55, 1, 10, 5))
+        self.failUnlessEqual(self.cursor.rowcount, 10)
+        self.cursor.execute("""
+                select IntCol, NullableCol, mod(IntCol, 2)
+                from TestNumbers""")
+        result = self.cursor.aggregate([("count", None), ("sum", 0),
+                ("max", 1)], groupBy = 2)
+        self.failUnlessEqual(result,
+                { 0: (5, 30, None), 1: (5, 25, 143 ** 9) })
+        self.failUnlessRaises(cx_Oracle.InterfaceError,
+                self.cursor.aggregate, [("avg", 0)])
+        self.failUnlessRaises(cx_Oracle.InterfaceError,
+                self.cursor.aggregate, [])
+
     def testBindNames(self):
         """test that bindnames() works correctly."""
         self.failUnlessRaises(cx_Oracle.ProgrammingError,
@@ -251,3 +381,111 @@ class TestCursor(BaseTestCase):
                 end;""", [var, 'test_', 5, '_second_', 3, 7])
         self.failUnlessEqual(var.getvalue(), "test_5_second_37")
 
+    def testReexecuteQuery(self):
+        """test executing the same query again fetches the first batch"""
+        self.cursor.arraysize = 4
+        sql = "select IntCol from TestNumbers where IntCol <= :val " \
+                "order by IntCol"
+        self.cursor.execute(sql, val = 3)
+        self.failUnlessEqual(self.cursor.fetchall(), [(1,), (2,), (3,)])
+        self.cursor.execute(sql, val = 6)
+        self.failUnlessEqual(self.cursor.rowcount, 0)
+        self.failUnlessEqual(self.cursor.fetchall(),
+                [(1,), (2,), (3,), (4,), (5,), (6,)])
+        self.cursor.execute(sql, val = 2)
+        self.failUnlessEqual(self.cursor.fetchraw(), 2)
+        self.failUnlessEqual(self.cursor.fetchvars[0].getvalue(1), 2)
+        self.failUnlessEqual(self.cursor.fetchraw(), 0)
+
+    def testFetchSingle(self):
+        """test fetching a single row with fetchsingle()"""
+        sql = "select IntCol, StringCol from TestStrings where IntCol = :val"
+        self.failUnlessEqual(self.cursor.fetchsingle(sql, val = 3),
+                (3, "String 3"))
+        self.failUnlessEqual(self.cursor.fetchsingle(sql, [7]),
+                (7, "String 7"))
+        self.failUnlessEqual(self.cursor.fetchone(), None)
+        self.failUnlessEqual(self.cursor.fetchsingle(sql, val = 12), None)
+        self.failUnlessRaises(cx_Oracle.DatabaseError,
+                self.cursor.fetchsingle, "select IntCol from TestStrings")
+        self.failUnlessRaises(cx_Oracle.InterfaceError,
+                self.cursor.fetchsingle, "begin null; end;")
+        self.cursor.execute(sql, val = 5)
+        self.failUnlessEqual(self.cursor.fetchall(), [(5, "String 5")])
+
+    def testScrollAbsoluteInBuffer(self):
+        """test scrolling to an absolute position within the fetch buffer"""
+        cursor = self.connection.cursor(scrollable = True)
+        cursor.arraysize = 10
+        cursor.execute("select IntCol from TestNumbers order by IntCol")
+        cursor.fetchmany(5)
+        cursor.scroll(1, mode = "absolute")
+        self.failUnlessEqual(cursor.fetchone(), (2,))
+        self.failUnlessEqual(cursor.rowcount, 2)
+
+    def testScrollRelative(self):
+        """test scrolling relative to the current position"""
+        cursor = self.connection.cursor(scrollable = True)
+        cursor.arraysize = 3
+        cursor.execute("select IntCol from TestNumbers order by IntCol")
+        cursor.fetchmany()
+        cursor.scroll(4)
+        self.failUnlessEqual(cursor.fetchone(), (8,))
+        cursor.scroll(-4)
+        self.failUnlessEqual(cursor.fetchone(), (5,))
+        self.failUnlessEqual(cursor.rowcount, 5)
+        cursor.scroll(0)
+        self.failUnlessEqual(cursor.fetchone(), (6,))
+        cursor.scroll(1)
+        self.failUnlessEqual(cursor.fetchone(), (8,))
+
+    def testScrollFirstAndLast(self):
+        """test scrolling to the first and last rows"""
+        cursor = self.connection.cursor(scrollable = True)
+        cursor.arraysize = 4
+        cursor.execute("select IntCol from TestNumbers order by IntCol")
+        cursor.scroll(mode = "last")
+        self.failUnlessEqual(cursor.rowcount, 10)
+        self.failUnlessEqual(cursor.fetchall(), [])
+        cursor.scroll(-1)
+        self.failUnlessEqual(cursor.fetchall(), [(10,)])
+        cursor.scroll(mode = "first")
+        self.failUnlessEqual(cursor.rowcount, 1)
+        self.failUnlessEqual(cursor.fetchmany(2), [(2,), (3,)])
+        cursor.scroll(0, mode = "absolute")
+        self.failUnlessEqual(cursor.fetchone(), (1,))
+
+    def testScrollOutOfRange(self):
+        """test scrolling outside of the result set"""
+        cursor = self.connection.cursor(scrollable = True)
+        cursor.arraysize = 3
+        cursor.execute("select IntCol from TestNumbers order by IntCol")
+        self.failUnlessEqual(cursor.fetchone(), (1,))
+        self.failUnlessRaises(IndexError, cursor.scroll, 12,
+                mode = "absolute")
+        self.failUnlessRaises(IndexError, cursor.scroll, -2)
+        self.failUnlessEqual(cursor.rowcount, 1)
+        self.failUnlessEqual(cursor.fetchall(), [(i,) for i in range(2, 11)])
+        self.failUnlessRaises(cx_Oracle.InterfaceError, cursor.scroll,
+                mode = "middle")
+        self.failUnlessRaises(cx_Oracle.InterfaceError, self.cursor.scroll)
+
+    def testScrollOutOfRangeWithLOBs(self):
+        """test fetching LOBs after scrolling outside of the result set"""
+        self.cursor.execute("truncate table TestCLOBs")
+        for i in range(1, 6):
+            self.cursor.execute("""
+                    insert into TestCLOBs (IntCol, CLOBCol)
+                    values (:1, to_clob(:2))""", (i, "Value %d" % i))
+        self.connection.commit()
+        cursor = self.connection.cursor(scrollable = True)
+        cursor.arraysize = 3
+        cursor.execute("select IntCol, CLOBCol from TestCLOBs order by IntCol")
+        intCol, lob = cursor.fetchone()
+        self.failUnlessEqual(intCol, 1)
+        self.failUnlessRaises(IndexError, cursor.scroll, 8,
+                mode = "absolute")
+        self.failUnlessEqual(cursor.rowcount, 1)
+        rows = [(i, l.read()) for i, l in cursor.fetchall()]
+        self.failUnlessEqual(rows,
+                [(i, "Value %d" % i) for i in range(2, 6)])
@@ -226,3 +226,32 @@ class TestDateTimeVar(BaseTestCase):
         self.failUnlessEqual(self.cursor.fetchone(), self.dataByKey[4])
         self.failUnlessEqual(self.cursor.fetchone(), None)
 
+    def testFetchRepeatedDates(self):
+        "test that fetching the same date repeatedly returns the correct results"
+        self.cursor.execute("""
+                select trunc(DateCol), DateCol
+                from TestDates
+                order by IntCol""")
+        for intCol, dateCol, nullableCol in self.rawData:
+            truncatedDateCol = datetime.datetime(dateCol.year, dateCol.month,
+                    dateCol.day)
+            self.failUnlessEqual(self.cursor.fetchone(),
+                    (truncatedDateCol, dateCol))
+        self.cursor.execute("""
+                select to_date('2002-12-09', 'YYYY-MM-DD')
+                from TestDates""")
+        self.failUnlessEqual(self.cursor.fetchall(),
+                [(datetime.datetime(2002, 12, 9),)] * len(self.rawData))
+
+    def testFetchAsEpoch(self):
+        "test fetching dates as integers relative to the epoch"
+        self.cursor.timestampsAsEpoch = 1000000
+        self.cursor.execute("""
+                select
+                  to_date('1970-01-02 00:00:01', 'YYYY-MM-DD HH24:MI:SS'),
+                  to_date('1969-12-31', 'YYYY-MM-DD'),
+                  to_timestamp('2002-12-09 10:11:12.123456',
+                      'YYYY-MM-DD HH24:MI:SS.FF')
+                from dual""")
+        self.failUnlessEqual(self.cursor.fetchone(),
+                (86401000000, -86400000000, 1039428672123456))
@@ -4,7 +4,7 @@ import sys
 
 class TestLongVar(BaseTestCase):
 
-    def __PerformTest(self, a_Type, a_InputType):
+    def __PerformTest(self, a_Type, a_InputType, a_Dynamic = False):
         self.cursor.execute("truncate table Test%ss" % a_Type)
         longString = ""
         for i in range(1, 11):
@@ -26,7 +26,10 @@ class TestLongVar(BaseTestCase):
                     p_IntegerValue = i,
                     p_LongString = bindValue)
         self.connection.commit()
-        self.cursor.setoutputsize(250000, 2)
+        if a_Dynamic:
+            self.cursor.dynamicLongs = True
+        else:
+            self.cursor.setoutputsize(250000, 2)
         self.cursor.execute("""
                 select *
                 from Test%ss
@@ -54,6 +57,14 @@ class TestLongVar(BaseTestCase):
         "test binding and fetching long raw data"
         self.__PerformTest("LongRaw", cx_Oracle.LONG_BINARY)
 
+    def testLongsDynamic(self):
+        "test binding and fetching long data dynamically"
+        self.__PerformTest("Long", cx_Oracle.LONG_STRING, True)
+
+    def testLongRawsDynamic(self):
+        "test binding and fetching long raw data dynamically"
+        self.__PerformTest("LongRaw", cx_Oracle.LONG_BINARY, True)
+
     def testLongCursorDescription(self):
         "test cursor description is accurate for longs"
         self.cursor.execute("select * from TestLongs")
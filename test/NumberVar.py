@@ -68,6 +68,16 @@ class TestNumberVar(BaseTestCase):
         value = valueVar.getvalue()
         self.failUnlessEqual(value, 6088343249)
 
+    def testSetAndGetValues(self):
+        "test setting and getting a range of values in a variable"
+        var = self.cursor.var(cx_Oracle.NUMBER, arraysize = 5)
+        var.setvalues([1, None, 3], 1)
+        self.failUnlessEqual(var.getvalues(1, 3), [1, None, 3])
+        self.failUnlessEqual(var.getvalues(start = 3), [3, None])
+        self.failUnlessEqual(var.getvalue(2), None)
+        self.failUnlessRaises(IndexError, var.setvalues, [1, 2], 4)
+        self.failUnlessRaises(IndexError, var.getvalues, 2, 4)
+
     def testBindIntegerAfterString(self):
         "test binding in an number after setting input sizes to a string"
         self.cursor.setinputsizes(value = 15)
@@ -254,6 +264,20 @@ class TestNumberVar(BaseTestCase):
         self.failUnlessEqual(self.cursor.fetchone(), self.dataByKey[4])
         self.failUnlessEqual(self.cursor.fetchone(), None)
 
+    def testFetchAsNativeFloats(self):
+        "test fetching non-integral numbers as native floats"
+        self.cursor.numbersAsNativeFloats = True
+        self.cursor.execute("""
+                select IntCol, NumberCol
+                from TestNumbers
+                where IntCol = 3""")
+        self.failUnless(isinstance(self.cursor.fetchvars[1],
+                cx_Oracle.NATIVE_FLOAT), "native float variable not created")
+        intCol, numberCol = self.cursor.fetchone()
+        self.failUnlessEqual(intCol, 3)
+        self.failUnlessEqual(numberCol, 3.75)
+        self.failUnless(isinstance(numberCol, float), "float not returned")
+
     def testReturnAsLong(self):
         "test that fetching a long integer returns such in Python"
         self.cursor.execute("""
@@ -0,0 +1,113 @@
+"""Module for testing pool groups."""
+
+import sys
+
+class TestPoolGroup(TestCase):
+
+    def __CreatePool(self, max = 4, getmode = cx_Oracle.SPOOL_ATTRVAL_NOWAIT):
+        """Create a session pool for use in a pool group."""
+        return cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 0, max, 1,
+                getmode = getmode)
+
+    def testPoolGroup(self):
+        "test that the pool group is created and has the right attributes"
+        pool1 = self.__CreatePool()
+        pool2 = self.__CreatePool()
+        group = cx_Oracle.PoolGroup([pool1, pool2])
+        self.failUnlessEqual(group.pools, (pool1, pool2))
+        self.failUnlessEqual(group.policy, cx_Oracle.POOLGROUP_LEASTBUSY)
+        self.failUnlessEqual(group.retrydelay, 30)
+        self.failUnlessEqual(group.available, [pool1, pool2])
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, cx_Oracle.PoolGroup,
+                [])
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, cx_Oracle.PoolGroup,
+                [pool1, 1])
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, cx_Oracle.PoolGroup,
+                [pool1, pool2], cx_Oracle.POOLGROUP_WEIGHTED)
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, cx_Oracle.PoolGroup,
+                [pool1, pool2], cx_Oracle.POOLGROUP_WEIGHTED, [1, 0])
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, group.__init__,
+                [pool1])
+        self.failUnlessEqual(group.pools, (pool1, pool2))
+
+    def testLeastBusy(self):
+        "test acquiring from the pool with the fewest busy sessions"
+        pool1 = self.__CreatePool()
+        pool2 = self.__CreatePool()
+        group = cx_Oracle.PoolGroup([pool1, pool2])
+        connections = [group.acquire() for i in range(4)]
+        self.failUnlessEqual(pool1.busy, 2)
+        self.failUnlessEqual(pool2.busy, 2)
+        group.release(connections[0])
+        group.release(connections[2])
+        self.failUnlessEqual(pool1.busy, 0)
+        self.failUnlessEqual(pool2.busy, 2)
+        connection = group.acquire()
+        self.failUnlessEqual(pool1.busy, 1)
+        self.failUnlessEqual(pool2.busy, 2)
+
+    def testRoundRobin(self):
+        "test acquiring from each pool in turn"
+        pool1 = self.__CreatePool()
+        pool2 = self.__CreatePool()
+        group = cx_Oracle.PoolGroup([pool1, pool2],
+                cx_Oracle.POOLGROUP_ROUNDROBIN)
+        connection = group.acquire()
+        self.failUnlessEqual((pool1.busy, pool2.busy), (1, 0))
+        group.release(connection)
+        connection = group.acquire()
+        self.failUnlessEqual((pool1.busy, pool2.busy), (0, 1))
+
+    def testWeighted(self):
+        "test acquiring from the pools in proportion to their weights"
+        pool1 = self.__CreatePool()
+        pool2 = self.__CreatePool()
+        group = cx_Oracle.PoolGroup([pool1, pool2],
+                cx_Oracle.POOLGROUP_WEIGHTED, [3, 1])
+        connections = [group.acquire() for i in range(4)]
+        self.failUnlessEqual((pool1.busy, pool2.busy), (3, 1))
+
+    def testBusyPoolSkipped(self):
+        "test that a pool with no free sessions is skipped but kept"
+        pool1 = self.__CreatePool(1)
+        pool2 = self.__CreatePool(1)
+        group = cx_Oracle.PoolGroup([pool1, pool2],
+                cx_Oracle.POOLGROUP_ROUNDROBIN)
+        connection1 = group.acquire()
+        connection2 = group.acquire()
+        self.failUnlessEqual((pool1.busy, pool2.busy), (1, 1))
+        self.failUnlessRaises(cx_Oracle.DatabaseError, group.acquire)
+        self.failUnlessEqual(group.available, [pool1, pool2])
+
+    def testOtherErrorRaised(self):
+        "test that errors not caused by an unreachable pool are raised"
+        pool1 = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 0, 4, 1,
+                homogeneous = False)
+        pool2 = self.__CreatePool()
+        group = cx_Oracle.PoolGroup([pool1, pool2],
+                cx_Oracle.POOLGROUP_ROUNDROBIN)
+        try:
+            group.acquire(user = "%s_nosuchuser" % USERNAME)
+        except cx_Oracle.DatabaseError:
+            self.failIf(isinstance(sys.exc_info()[1],
+                    cx_Oracle.ProgrammingError),
+                    "homogeneous pool should not have been tried")
+        else:
+            self.fail("acquire did not fail")
+        self.failUnlessEqual(group.available, [pool1, pool2])
+        self.failUnlessEqual((pool1.busy, pool2.busy), (0, 0))
+
+    def testRelease(self):
+        "test releasing connections to the pools of the group"
+        pool1 = self.__CreatePool()
+        pool2 = self.__CreatePool()
+        group = cx_Oracle.PoolGroup([pool1])
+        connection = pool2.acquire()
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, group.release,
+                connection)
+        connection = group.acquire()
+        self.failUnlessEqual(pool1.busy, 1)
+        group.drop(connection)
+        self.failUnlessEqual(pool1.busy, 0)
+        self.failUnlessEqual(pool1.opened, 0)
+
@@ -1,5 +1,6 @@
 """Module for testing session pools."""
 
+import sys
 import threading
 
 class TestConnection(TestCase):
@@ -91,6 +92,223 @@ class TestConnection(TestCase):
         count, = cursor.fetchone()
         self.failUnlessEqual(count, 0)
 
+    def testRollbackOnReleaseAfterCommit(self):
+        "connection rolls back changes made after commit before release"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 8, 3)
+        connection = pool.acquire()
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestExecuteMany")
+        cursor.execute("insert into TestExecuteMany (IntCol) values (1)")
+        connection.commit()
+        pool.release(connection)
+        connection = pool.acquire()
+        cursor = connection.cursor()
+        cursor.execute("insert into TestExecuteMany (IntCol) values (2)")
+        pool.release(connection)
+        connection = pool.acquire()
+        cursor = connection.cursor()
+        cursor.execute("select count(*) from TestExecuteMany")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 1)
+
+    def testStats(self):
+        "test that the pool gathers statistics"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 8, 3)
+        connection_1 = pool.acquire()
+        connection_2 = pool.acquire()
+        pool.release(connection_1)
+        pool.drop(connection_2)
+        stats = pool.stats(reset = True)
+        self.failUnlessEqual(stats["acquires"], 2)
+        self.failUnlessEqual(stats["acquireErrors"], 0)
+        self.failUnlessEqual(stats["releases"], 1)
+        self.failUnlessEqual(stats["drops"], 1)
+        self.failUnlessEqual(stats["sessionsCreated"], 3)
+        self.failUnlessEqual(stats["sessionsReused"], 1)
+        self.failUnlessEqual(stats["peakBusy"], 2)
+        self.failUnlessEqual(sum([c for b, c in stats["waitHistogram"]]), 2)
+        self.failUnlessEqual(stats["waitHistogram"][-1][0], None)
+        self.failUnlessEqual(pool.stats()["acquires"], 0)
+
+    def testAcquireTimeout(self):
+        "test that acquiring with a timeout fails when the pool is busy"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1,
+                getmode = cx_Oracle.SPOOL_ATTRVAL_NOWAIT)
+        connection_1 = pool.acquire(timeout = 0.05)
+        connection_2 = pool.acquire(timeout = 0.05)
+        try:
+            pool.acquire(timeout = 0.05)
+        except cx_Oracle.DatabaseError:
+            errorObj, = sys.exc_info()[1].args
+            self.failUnlessEqual(errorObj.code, 24457)
+        else:
+            self.fail("acquire did not time out")
+        pool.release(connection_2)
+        connection_2 = pool.acquire(timeout = 0.05)
+        stats = pool.stats()
+        self.failUnlessEqual(stats["acquires"], 3)
+        self.failUnlessEqual(stats["acquireErrors"], 1)
+        self.failUnlessEqual(stats["timeouts"], 1)
+        self.failUnlessEqual(stats["exhausted"], 0)
+        self.failUnlessEqual(sum([c for b, c in stats["waitHistogram"]]), 4)
+
+    def testAcquireTimeoutReleased(self):
+        "test that acquiring with a timeout waits for a session to be released"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 1, 1,
+                threaded = True)
+        connection = pool.acquire()
+        timer = threading.Timer(0.1, pool.release, (connection,))
+        timer.start()
+        connection = pool.acquire(timeout = 5)
+        timer.join()
+        self.failUnlessEqual(pool.busy, 1)
+
+    def testAcquireTimeoutWithWaitMode(self):
+        "test that acquiring with a timeout requires a bounded get mode"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1,
+                getmode = cx_Oracle.SPOOL_ATTRVAL_WAIT)
+        self.failUnlessRaises(cx_Oracle.ProgrammingError, pool.acquire,
+                timeout = 0.05)
+
+    def testTagging(self):
+        "test that sessions can be tagged and acquired by tag"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 8, 3)
+        tag = "NLS_DATE_FORMAT=YYYY-MM-DD"
+        connection = pool.acquire(tag = tag)
+        self.failUnlessEqual(connection.tagmatched, False)
+        cursor = connection.cursor()
+        cursor.execute("alter session set nls_date_format = 'YYYY-MM-DD'")
+        pool.release(connection, tag = tag)
+        connection = pool.acquire(tag = tag)
+        self.failUnlessEqual(connection.tag, tag)
+        self.failUnlessEqual(connection.tagmatched, True)
+        cursor = connection.cursor()
+        cursor.execute("""
+                select value
+                from nls_session_parameters
+                where parameter = 'NLS_DATE_FORMAT'""")
+        value, = cursor.fetchone()
+        self.failUnlessEqual(value, "YYYY-MM-DD")
+
+    def testAcquireAfterRelease(self):
+        "test that connections acquired again start with a clean state"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1)
+        connection = pool.acquire()
+        connection.autocommit = True
+        pool.release(connection)
+        del connection
+        connection = pool.acquire()
+        self.failUnless(isinstance(connection, cx_Oracle.Connection))
+        self.failUnlessEqual(connection.autocommit, False)
+        cursor = connection.cursor()
+        cursor.execute("select count(*) from TestNumbers")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+
+    def testAcquireAfterPoolFreed(self):
+        "test that connections parked by a freed pool are not reused"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1)
+        connection = pool.acquire()
+        pool.release(connection)
+        del connection
+        del pool
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1)
+        connection = pool.acquire()
+        cursor = connection.cursor()
+        cursor.execute("select count(*) from TestNumbers")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+
+    def testAcquireWithPurityNone(self):
+        "test that acquire rejects a purity of None like the constructor"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1)
+        self.failUnlessRaises(TypeError, pool.acquire, purity = None)
+
+    def testWarmup(self):
+        "test that warming up the pool opens sessions ahead of time"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 8, 1)
+        tag = "NLS_DATE_FORMAT=YYYY-MM-DD"
+        numOpened = pool.warmup(4,
+                "alter session set nls_date_format = 'YYYY-MM-DD'", tag)
+        self.failUnlessEqual(numOpened, 3)
+        self.failUnlessEqual(pool.opened, 4)
+        self.failUnlessEqual(pool.busy, 0)
+        connection = pool.acquire(tag = tag)
+        self.failUnlessEqual(connection.tagmatched, True)
+        self.failUnlessEqual(pool.warmup(2), 0)
+
+    def testWarmupWithBusySessions(self):
+        "test that warming up the pool only acquires sessions not busy"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 2, 1)
+        connection = pool.acquire()
+        self.failUnlessEqual(pool.warmup(4), 1)
+        self.failUnlessEqual(pool.opened, 2)
+        self.failUnlessEqual(pool.busy, 1)
+
+    def testWarmupWithFailedStatement(self):
+        "test that sessions on which the warmup statement fails are dropped"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 1, 8, 1)
+        tag = "NLS_DATE_FORMAT=YYYY-MM-DD"
+        self.failUnlessRaises(cx_Oracle.DatabaseError, pool.warmup, 2,
+                "alter session set bogus_parameter = 1", tag)
+        self.failUnlessEqual(pool.busy, 0)
+        connection = pool.acquire(tag = tag)
+        self.failUnlessEqual(connection.tagmatched, False)
+
+    def testLazyAcquire(self):
+        "test that lazily acquired connections get a session when used"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 0, 2, 1)
+        connection = pool.acquire(lazy = True)
+        self.failUnlessEqual(pool.busy, 0)
+        pool.release(connection)
+        connection = pool.acquire(lazy = True)
+        cursor = connection.cursor()
+        self.failUnlessEqual(pool.busy, 0)
+        cursor.execute("select count(*) from TestNumbers")
+        count, = cursor.fetchone()
+        self.failUnlessEqual(count, 10)
+        self.failUnlessEqual(pool.busy, 1)
+        pool.release(connection)
+        self.failUnlessEqual(pool.busy, 0)
+
+    def testLazyAcquireTransactionControl(self):
+        "test that transaction control does not acquire a lazy session"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 0, 2, 1)
+        connection = pool.acquire(lazy = True)
+        connection.commit()
+        connection.rollback()
+        connection.cancel()
+        connection.__enter__()
+        connection.__exit__(None, None, None)
+        self.failUnlessEqual(pool.busy, 0)
+        self.failUnlessEqual(pool.opened, 0)
+        pool.release(connection)
+
+    def testLazyAcquireThreaded(self):
+        "test that threads sharing a lazy connection acquire one session"
+        pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 0, 4, 1,
+                threaded = True)
+        connection = pool.acquire(lazy = True)
+        errors = []
+        def query():
+            try:
+                cursor = connection.cursor()
+                cursor.execute("select count(*) from TestNumbers")
+                count, = cursor.fetchone()
+                self.failUnlessEqual(count, 10)
+            except:
+                errors.append(sys.exc_info())
+        threads = [threading.Thread(target = query) for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        if errors:
+            excType, excValue, excTraceback = errors[0]
+            raise excValue
+        self.failUnlessEqual(pool.busy, 1)
+        pool.release(connection)
+
     def testThreading(self):
         """test session pool to database with multiple threads"""
         self.pool = cx_Oracle.SessionPool(USERNAME, PASSWORD, TNSENTRY, 5, 20,
@@ -128,6 +128,12 @@ create table cx_Oracle.TestIntervals (
   NullableCol           interval day to second
 ) tablespace users;
 
+create table cx_Oracle.TestCopyTimestamps (
+  IntCol                number(9) not null,
+  TimestampCol          timestamp not null,
+  NullableCol           timestamp
+) tablespace users;
+
 alter table cx_Oracle.testexecutemany
 add constraint testexecutemany_pk
 primary key (
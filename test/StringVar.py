@@ -284,3 +284,22 @@ class TestStringVar(BaseTestCase):
         self.failUnlessEqual(self.cursor.fetchone(), self.dataByKey[4])
         self.failUnlessEqual(self.cursor.fetchone(), None)
 
+    def testFetchWithStringDefineSize(self):
+        "test fetching strings larger than the space allocated for them"
+        self.cursor.stringDefineSize = 8
+        self.cursor.execute("select * From TestStrings order by IntCol")
+        self.failUnlessEqual(self.cursor.fetchall(), self.rawData)
+
+    def testStringDefineSizeWithOutputTypeHandler(self):
+        "test that output type handlers are passed the size of the column"
+        sizes = []
+        def OutputTypeHandler(cursor, name, defaultType, size, precision,
+                scale):
+            if defaultType == cx_Oracle.STRING:
+                sizes.append(size)
+                return cursor.var(defaultType, size, cursor.arraysize)
+        self.cursor.stringDefineSize = 8
+        self.cursor.outputtypehandler = OutputTypeHandler
+        self.cursor.execute("select * From TestStrings order by IntCol")
+        self.failUnlessEqual(self.cursor.fetchall(), self.rawData)
+        self.failUnless(sizes and min(sizes) > 8, "column size not passed")
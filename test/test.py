@@ -34,6 +34,7 @@ else:
             "uNumberVar",
             "ObjectVar",
             "uObjectVar",
+            "PoolGroup",
             "SessionPool",
             "uSessionPool",
             "StringVar",
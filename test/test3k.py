@@ -24,6 +24,7 @@ else:
             "LongVar",
             "3kNumberVar",
             "ObjectVar",
+            "PoolGroup",
             "SessionPool",
             "3kStringVar",
             "TimestampVar"